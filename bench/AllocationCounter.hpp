@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+
+namespace bench
+{
+
+// Number of global operator new calls since program start (counted by the
+// replacement operators in AllocationCounter.cpp, linked into the bench and
+// the tests only)
+std::size_t allocationCount();
+
+} // namespace bench
@@ -0,0 +1,56 @@
+// Cost of building the sprite atlas and of packing alone, with the density
+// reached (the tests check the packing itself).
+#include "TextureAtlas.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+namespace
+{
+void reportPacking(benchmark::State& state, const sf::Vector2u& size, float density)
+{
+    state.counters["density"] = density;
+    state.counters["texels"] = static_cast<double>(size.x) * size.y;
+}
+
+sf::Image solidImage(unsigned int width, unsigned int height, const sf::Color& color)
+{
+    sf::Image image;
+    image.create(width, height, color);
+    return image;
+}
+
+// Sizes of the shipped PNGs
+void BM_Atlas_Build(benchmark::State& state)
+{
+    sf::Image ball = solidImage(512, 512, sf::Color::White);
+    sf::Image brick = solidImage(1024, 512, sf::Color(200, 200, 200));
+    sf::Image paddle = solidImage(1024, 256, sf::Color::White);
+
+    TextureAtlas atlas;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(atlas.build(ball, brick, paddle));
+    }
+    reportPacking(state, atlas.getImage().getSize(), atlas.getDensity());
+}
+BENCHMARK(BM_Atlas_Build)->Unit(benchmark::kMillisecond);
+
+// Packer alone over a mixed set of sprite sizes (e.g. more brick types later)
+void BM_Atlas_PackMixed(benchmark::State& state)
+{
+    std::vector<sf::Vector2u> sizes;
+    for (int i = 0; i < state.range(0); ++i)
+    {
+        sizes.emplace_back(16u + (i * 37u) % 112u, 16u + (i * 23u) % 48u);
+    }
+
+    AtlasPacking packing;
+    for (auto _ : state)
+    {
+        packing = packAtlas(sizes, TextureAtlas::PADDING);
+        benchmark::DoNotOptimize(packing.size);
+    }
+    reportPacking(state, packing.size, packing.getDensity());
+}
+BENCHMARK(BM_Atlas_PackMixed)->Arg(8)->Arg(32)->Unit(benchmark::kMicrosecond);
+} // namespace
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "AllocationCounter.hpp"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+
+namespace bench
+{
+
+// Reports the allocations made since `before` as a counter; the tests are
+// what fail on them
+inline void reportAllocations(benchmark::State& state, std::size_t before)
+{
+    state.counters["allocs"] = static_cast<double>(allocationCount() - before);
+}
+
+// Reports the allocations made since `before` as a counter and fails the
+// benchmark if there were any
+inline void requireNoAllocations(benchmark::State& state, std::size_t before)
+{
+    std::size_t allocations = allocationCount() - before;
+    state.counters["allocs"] = static_cast<double>(allocations);
+    if (allocations != 0)
+    {
+        state.SkipWithError("steady-state loop allocated on the heap");
+    }
+}
+
+} // namespace bench
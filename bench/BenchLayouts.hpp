@@ -0,0 +1,86 @@
+#pragma once
+
+#include "BrickField.hpp"
+#include "CollisionBatch.hpp"
+#include "Simulation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace bench
+{
+
+// count bricks packed into the top half of the playfield, in rows of
+// roughly twice as many columns, with the game's usual spacing ratio.
+inline BrickField makeBrickLayout(int count, int maxHealth = 1)
+{
+    int cols = std::max(1, static_cast<int>(std::ceil(std::sqrt(2.f * static_cast<float>(count)))));
+    int rows = (count + cols - 1) / cols;
+
+    float pitchX = static_cast<float>(Simulation::WINDOW_WIDTH) / static_cast<float>(cols);
+    float pitchY = (Simulation::WINDOW_HEIGHT / 2.f - 50.f) / static_cast<float>(rows);
+    float gap = std::min(pitchX, pitchY) / 15.f;
+
+    BrickField layout;
+    layout.reserve(static_cast<std::size_t>(count));
+    for (int i = 0; i < count; ++i)
+    {
+        float x = static_cast<float>(i % cols) * pitchX;
+        float y = 50.f + static_cast<float>(i / cols) * pitchY;
+        layout.add(x, y, pitchX - gap, pitchY - gap, maxHealth);
+    }
+    return layout;
+}
+
+// One ball against a batch of bricks, as a dense level's grid query hands them
+// out: a 4 x 2 block around the ball, with random sizes for half the batches.
+struct SweepBatchCase
+{
+    sf::Vector2f center;
+    sf::Vector2f displacement;
+    collision::BoxBatch boxes;
+};
+
+inline std::vector<SweepBatchCase> makeSweepBatchCases()
+{
+    constexpr float BRICK_WIDTH{70.f};
+    constexpr float BRICK_HEIGHT{30.f};
+
+    std::mt19937 random(12345);
+    std::uniform_real_distribution<float> jitter(-1.f, 1.f);
+    std::vector<SweepBatchCase> cases;
+    for (int i = 0; i < 4096; ++i)
+    {
+        SweepBatchCase batch;
+        bool mixed = i % 2 != 0;
+        std::size_t count = i % 4 == 3 ? 1 + static_cast<std::size_t>(i / 4) % collision::SWEEP_BATCH
+                                       : collision::SWEEP_BATCH;
+        for (std::size_t k = 0; k < count; ++k)
+        {
+            float width = mixed ? 50.f + 30.f * std::abs(jitter(random)) : BRICK_WIDTH;
+            float height = mixed ? 20.f + 15.f * std::abs(jitter(random)) : BRICK_HEIGHT;
+            batch.boxes.push(100.f + static_cast<float>(k % 4) * 75.f, 100.f + static_cast<float>(k / 4) * 35.f,
+                             width, height);
+        }
+        batch.center = sf::Vector2f(250.f + 180.f * jitter(random), 135.f + 90.f * jitter(random));
+        batch.displacement = sf::Vector2f(12.f * jitter(random), 12.f * jitter(random));
+        // Axis-aligned and resting balls take their own branches of the sweep
+        if (i % 16 == 5)
+        {
+            batch.displacement.x = 0.f;
+        }
+        if (i % 16 == 9)
+        {
+            batch.displacement.y = 0.f;
+        }
+        if (i % 64 == 13)
+        {
+            batch.displacement = sf::Vector2f();
+        }
+        cases.push_back(batch);
+    }
+    return cases;
+}
+
+} // namespace bench
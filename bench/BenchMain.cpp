@@ -0,0 +1,84 @@
+// Entry point of the bench, in place of benchmark_main: the checks inside the
+// benchmarks report failures with SkipWithError, which Google Benchmark prints
+// but does not turn into an exit status. Here any errored run makes the
+// process exit with 1, so a failing check also fails a script or CI job.
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Google Benchmark 1.8 replaced Run::error_occurred with Run::skipped
+template <typename Run>
+auto isError(const Run& run, int) -> decltype(static_cast<bool>(run.error_occurred))
+{
+    return run.error_occurred;
+}
+
+template <typename Run>
+auto isError(const Run& run, long) -> decltype(run.skipped == decltype(run.skipped)::SkippedWithError)
+{
+    return run.skipped == decltype(run.skipped)::SkippedWithError;
+}
+
+// Forwards to the display reporter picked by the --benchmark_* flags and keeps
+// the names of the runs that reported an error
+class ErrorCountingReporter : public benchmark::BenchmarkReporter
+{
+public:
+    explicit ErrorCountingReporter(std::unique_ptr<benchmark::BenchmarkReporter> display)
+        : m_display(std::move(display))
+    {
+    }
+
+    bool ReportContext(const Context& context) override { return m_display->ReportContext(context); }
+
+    void ReportRuns(const std::vector<Run>& runs) override
+    {
+        for (const Run& run : runs)
+        {
+            if (isError(run, 0))
+            {
+                m_failed.push_back(run.benchmark_name());
+            }
+        }
+        m_display->ReportRuns(runs);
+    }
+
+    void Finalize() override { m_display->Finalize(); }
+
+    const std::vector<std::string>& getFailed() const { return m_failed; }
+
+private:
+    std::unique_ptr<benchmark::BenchmarkReporter> m_display;
+    std::vector<std::string> m_failed;
+};
+} // namespace
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+
+    ErrorCountingReporter reporter(std::unique_ptr<benchmark::BenchmarkReporter>(
+        benchmark::CreateDefaultDisplayReporter()));
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+    benchmark::Shutdown();
+
+    if (!reporter.getFailed().empty())
+    {
+        std::fprintf(stderr, "%zu benchmark run(s) reported an error:\n", reporter.getFailed().size());
+        for (const std::string& name : reporter.getFailed())
+        {
+            std::fprintf(stderr, "  %s\n", name.c_str());
+        }
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,259 @@
+// Per-frame cost of the brick storage paths (collision scan, victory check,
+// cleanup, render traversal): legacy vector<unique_ptr<Brick>> vs BrickField.
+#include "Ball.hpp"
+#include "BenchLayouts.hpp"
+#include "Brick.hpp"
+#include "BrickField.hpp"
+#include "SpatialGrid.hpp"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+namespace
+{
+using LegacyBricks = std::vector<std::unique_ptr<Brick>>;
+
+LegacyBricks makeLegacy(const BrickField& field)
+{
+    LegacyBricks legacy;
+    legacy.reserve(field.size());
+    for (std::size_t i = 0; i < field.size(); ++i)
+    {
+        sf::FloatRect aabb = field.getAABB(i);
+        legacy.push_back(std::make_unique<Brick>(aabb.left, aabb.top, aabb.width, aabb.height, field.getMaxHealth(i)));
+    }
+    return legacy;
+}
+
+int brickCount(const benchmark::State& state)
+{
+    return static_cast<int>(state.range(0));
+}
+
+// Ball parked off the field so every brick goes through the full narrow-phase
+Ball parkedBall()
+{
+    return Ball(-100.f, -100.f, 8.f, sf::Vector2f(0.f, 0.f));
+}
+
+void BM_Legacy_Collide(benchmark::State& state)
+{
+    LegacyBricks legacy = makeLegacy(bench::makeBrickLayout(brickCount(state), 5));
+    Ball ball = parkedBall();
+    for (auto _ : state)
+    {
+        int hits = 0;
+        for (const auto& brick : legacy)
+        {
+            hits += !brick->isDestroyed() && ball.checkCollisionWithAABB(brick->getAABB());
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_BrickField_Collide(benchmark::State& state)
+{
+    BrickField field = bench::makeBrickLayout(brickCount(state), 5);
+    Ball ball = parkedBall();
+    for (auto _ : state)
+    {
+        int hits = 0;
+        for (std::size_t i = 0; i < field.size(); ++i)
+        {
+            hits += field.isAlive(i) && ball.checkCollisionWithAABB(field.getAABB(i));
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Victory checks are timed at the end of a level: only the last brick is left,
+// so the whole field has to be scanned
+void BM_Legacy_Victory(benchmark::State& state)
+{
+    LegacyBricks legacy = makeLegacy(bench::makeBrickLayout(brickCount(state), 5));
+    for (std::size_t i = 0; i + 1 < legacy.size(); ++i)
+    {
+        legacy[i]->takeDamage(5);
+    }
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::all_of(legacy.begin(), legacy.end(),
+                                             [](const auto& brick) { return brick->isDestroyed(); }));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_BrickField_Victory(benchmark::State& state)
+{
+    BrickField field = bench::makeBrickLayout(brickCount(state), 5);
+    for (std::size_t i = 0; i + 1 < field.size(); ++i)
+    {
+        field.destroy(i);
+    }
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(field.allDestroyed());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Cleanup pass of the old game loop: scan for destroyed bricks and erase them.
+// Each iteration starts from a fresh field where every eighth brick was just destroyed.
+void BM_Legacy_Cleanup(benchmark::State& state)
+{
+    BrickField layout = bench::makeBrickLayout(brickCount(state), 5);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        LegacyBricks legacy = makeLegacy(layout);
+        for (std::size_t i = 0; i < legacy.size(); i += 8)
+        {
+            legacy[i]->takeDamage(5);
+        }
+        state.ResumeTiming();
+
+        legacy.erase(std::remove_if(legacy.begin(), legacy.end(),
+                                    [](const auto& brick) { return brick->isDestroyed(); }),
+                     legacy.end());
+        benchmark::DoNotOptimize(legacy.size());
+
+        state.PauseTiming();
+        legacy.clear(); // Freeing the bricks is not part of the cleanup pass
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// A whole level's worth of deaths, each followed by the victory check, as the
+// simulation does them. The cost per brick must not grow with the field size;
+// victory must show up on the last death and not before.
+void BM_BrickField_DestroyAll(benchmark::State& state)
+{
+    BrickField layout = bench::makeBrickLayout(brickCount(state), 2);
+    BrickField field;
+    bool correct = true;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        field = layout;
+        field.reserveChangeLog();
+        state.ResumeTiming();
+
+        // Every brick takes two hits, in a scattered order
+        for (int hit = 0; hit < 2; ++hit)
+        {
+            for (std::size_t i = 0, index = 0; i < field.size(); ++i, index = (index + 7919) % field.size())
+            {
+                bool destroyed = field.takeDamage(index);
+                correct = correct && destroyed == (hit == 1) &&
+                          field.allDestroyed() == (hit == 1 && i + 1 == field.size());
+            }
+        }
+    }
+    if (!correct || field.countAlive() != 0)
+    {
+        state.SkipWithError("live count out of step with the bricks");
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Dropping the destroyed half of the bricks from the collision grid
+void BM_SpatialGrid_Compact(benchmark::State& state)
+{
+    BrickField field = bench::makeBrickLayout(brickCount(state), 1);
+    std::vector<sf::FloatRect> boxes;
+    for (std::size_t i = 0; i < field.size(); ++i)
+    {
+        boxes.push_back(field.getAABB(i));
+        if (i % 2 == 0)
+        {
+            field.destroy(i);
+        }
+    }
+
+    // Entries of live bricks, counted with a compaction that keeps everything
+    SpatialGrid grid(sf::Vector2f(boxes[0].width, boxes[0].height));
+    grid.build(boxes);
+    std::size_t liveEntries = 0;
+    grid.compact([&](std::uint32_t id)
+    {
+        liveEntries += field.isAlive(id);
+        return true;
+    });
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        grid.build(boxes);
+        state.ResumeTiming();
+
+        grid.compact([&field](std::uint32_t id) { return field.isAlive(id); });
+    }
+    bool stale = false;
+    grid.compact([&](std::uint32_t id)
+    {
+        stale = stale || !field.isAlive(id);
+        return true;
+    });
+    if (stale || grid.getEntryCount() != liveEntries)
+    {
+        state.SkipWithError("compaction kept destroyed bricks or lost live ones");
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_Legacy_DrawTraversal(benchmark::State& state)
+{
+    LegacyBricks legacy = makeLegacy(bench::makeBrickLayout(brickCount(state), 5));
+    for (auto _ : state)
+    {
+        float area = 0.f;
+        for (const auto& brick : legacy)
+        {
+            if (!brick->isDestroyed())
+            {
+                sf::FloatRect aabb = brick->getAABB();
+                area += aabb.width * aabb.height + static_cast<float>(brick->getHealth());
+            }
+        }
+        benchmark::DoNotOptimize(area);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_BrickField_DrawTraversal(benchmark::State& state)
+{
+    BrickField field = bench::makeBrickLayout(brickCount(state), 5);
+    for (auto _ : state)
+    {
+        float area = 0.f;
+        for (std::size_t i = 0; i < field.size(); ++i)
+        {
+            if (field.isAlive(i))
+            {
+                area += field.widthData()[i] * field.heightData()[i] + static_cast<float>(field.healthData()[i]);
+            }
+        }
+        benchmark::DoNotOptimize(area);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void brickCounts(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgName("bricks")->RangeMultiplier(10)->Range(100, 100000);
+}
+
+BENCHMARK(BM_Legacy_Collide)->Apply(brickCounts);
+BENCHMARK(BM_BrickField_Collide)->Apply(brickCounts);
+BENCHMARK(BM_Legacy_Victory)->Apply(brickCounts);
+BENCHMARK(BM_BrickField_Victory)->Apply(brickCounts);
+BENCHMARK(BM_Legacy_Cleanup)->Apply(brickCounts);
+BENCHMARK(BM_BrickField_DestroyAll)->Apply(brickCounts);
+BENCHMARK(BM_SpatialGrid_Compact)->Apply(brickCounts);
+BENCHMARK(BM_Legacy_DrawTraversal)->Apply(brickCounts);
+BENCHMARK(BM_BrickField_DrawTraversal)->Apply(brickCounts);
+} // namespace
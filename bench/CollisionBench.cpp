@@ -0,0 +1,203 @@
+// Per-call cost of the object-level collision primitives, and of the
+// circle-vs-box kernels with runtime (generic) and compile-time dimensions.
+#include "Ball.hpp"
+#include "BenchLayouts.hpp"
+#include "Brick.hpp"
+#include "Collision.hpp"
+#include "CollisionBatch.hpp"
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+const sf::FloatRect BRICK_BOX(100.f, 100.f, 70.f, 30.f);
+
+// Ball positions: well clear of the brick, or overlapping its bottom edge
+constexpr float MISS_Y{300.f};
+constexpr float HIT_Y{125.f};
+constexpr float BALL_RADIUS{8.f};
+
+struct BenchBrick
+{
+    static constexpr float WIDTH{70.f};
+    static constexpr float HEIGHT{30.f};
+    static constexpr float RADIUS{BALL_RADIUS};
+};
+using FixedShape = collision::FixedBoxShape<BenchBrick>;
+const collision::BoxShape GENERIC_SHAPE{BRICK_BOX.width, BRICK_BOX.height, BALL_RADIUS};
+
+// Ball centres and displacements around the brick: hits on every side and
+// corner, grazes and misses
+struct SweepCase
+{
+    sf::Vector2f center;
+    sf::Vector2f displacement;
+};
+
+std::vector<SweepCase> makeSweepCases()
+{
+    std::vector<SweepCase> cases;
+    for (float y = 60.f; y <= 170.f; y += 5.5f)
+    {
+        for (float x = 60.f; x <= 210.f; x += 7.25f)
+        {
+            float dx = 100.f + BRICK_BOX.width / 2.f - x;
+            float dy = 100.f + BRICK_BOX.height / 2.f - y;
+            cases.push_back({sf::Vector2f(x, y), sf::Vector2f(dx * 0.6f, dy * 0.6f)});
+            cases.push_back({sf::Vector2f(x, y), sf::Vector2f(-dy * 0.3f, dx * 0.3f)});
+        }
+    }
+    return cases;
+}
+
+bool sameHit(bool found, const collision::SweepHit& hit, bool otherFound, const collision::SweepHit& other)
+{
+    return found == otherFound &&
+           (!found || (std::memcmp(&hit.time, &other.time, sizeof(float)) == 0 &&
+                       std::memcmp(&hit.normal, &other.normal, sizeof(sf::Vector2f)) == 0 &&
+                       hit.startedInside == other.startedInside));
+}
+
+void BM_Ball_CheckCollisionWithAABB(benchmark::State& state)
+{
+    bool hit = state.range(0) != 0;
+    Ball ball(120.f, hit ? HIT_Y : MISS_Y, 8.f, sf::Vector2f(0.f, -400.f));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ball.checkCollisionWithAABB(BRICK_BOX));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Ball_CheckCollisionWithAABB)->ArgName("hit")->Arg(0)->Arg(1);
+
+void BM_Ball_HandleCollisionWithAABB(benchmark::State& state)
+{
+    Ball ball(120.f, HIT_Y, 8.f, sf::Vector2f(0.f, -400.f));
+    for (auto _ : state)
+    {
+        // Put the ball back inside so every call takes the resolving path
+        ball.setPosition(120.f, HIT_Y);
+        ball.handleCollisionWithAABB(BRICK_BOX);
+        benchmark::DoNotOptimize(ball.getVelocity());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Ball_HandleCollisionWithAABB);
+
+template <typename Shape>
+void BM_Kernel_CircleIntersectsBox(benchmark::State& state, Shape shape)
+{
+    bool hit = state.range(0) != 0;
+    sf::Vector2f position(120.f, hit ? HIT_Y : MISS_Y);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(position);
+        benchmark::DoNotOptimize(collision::circleIntersectsBox(shape, position, BRICK_BOX.left, BRICK_BOX.top));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_Kernel_CircleIntersectsBox, generic, GENERIC_SHAPE)->ArgName("hit")->Arg(0)->Arg(1);
+BENCHMARK_CAPTURE(BM_Kernel_CircleIntersectsBox, fixed, FixedShape())->ArgName("hit")->Arg(0)->Arg(1);
+
+template <typename Shape>
+void BM_Kernel_ResolveCircleBox(benchmark::State& state, Shape shape)
+{
+    sf::Vector2f position;
+    sf::Vector2f velocity(0.f, -400.f);
+    for (auto _ : state)
+    {
+        position = sf::Vector2f(120.f, HIT_Y);
+        benchmark::DoNotOptimize(position);
+        collision::resolveCircleBox(shape, position, velocity, BRICK_BOX.left, BRICK_BOX.top);
+        benchmark::DoNotOptimize(velocity);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_Kernel_ResolveCircleBox, generic, GENERIC_SHAPE);
+BENCHMARK_CAPTURE(BM_Kernel_ResolveCircleBox, fixed, FixedShape());
+
+// Swept test over a spread of approaches (the brick narrow phase of a step).
+// The compile-time kernel must give bit-identical contacts to the generic one,
+// or replays recorded on the default wall would diverge.
+template <typename Shape>
+void BM_Kernel_SweepCircleBox(benchmark::State& state, Shape shape)
+{
+    std::vector<SweepCase> cases = makeSweepCases();
+    for (const SweepCase& sweep : cases)
+    {
+        collision::SweepHit hit;
+        collision::SweepHit generic;
+        bool found = collision::sweepCircleBox(shape, sweep.center, sweep.displacement, BRICK_BOX.left,
+                                               BRICK_BOX.top, hit);
+        bool genericFound = collision::sweepCircleAABB(sweep.center, sweep.displacement, BALL_RADIUS, BRICK_BOX,
+                                                       generic);
+        if (!sameHit(found, hit, genericFound, generic))
+        {
+            state.SkipWithError("kernel contact differs from sweepCircleAABB");
+            return;
+        }
+    }
+
+    std::size_t hits = 0;
+    for (auto _ : state)
+    {
+        for (const SweepCase& sweep : cases)
+        {
+            collision::SweepHit hit;
+            hits += collision::sweepCircleBox(shape, sweep.center, sweep.displacement, BRICK_BOX.left,
+                                              BRICK_BOX.top, hit);
+        }
+    }
+    benchmark::DoNotOptimize(hits);
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(cases.size()));
+}
+BENCHMARK_CAPTURE(BM_Kernel_SweepCircleBox, generic, GENERIC_SHAPE);
+BENCHMARK_CAPTURE(BM_Kernel_SweepCircleBox, fixed, FixedShape());
+
+// One ball against each of the batches; the tests check every path against the
+// scalar one bit for bit. SIMD paths are registered only where this build and
+// CPU can run them.
+void BM_Kernel_SweepCircleBoxes(benchmark::State& state, collision::SweepBatchPath path)
+{
+    std::vector<bench::SweepBatchCase> cases = bench::makeSweepBatchCases();
+    std::size_t hits = 0;
+    for (auto _ : state)
+    {
+        for (const bench::SweepBatchCase& batch : cases)
+        {
+            collision::SweepBatchHit result;
+            hits += collision::sweepCircleBoxes(path, batch.center, batch.displacement, BALL_RADIUS, batch.boxes,
+                                                result);
+        }
+    }
+    benchmark::DoNotOptimize(hits);
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(cases.size()));
+}
+
+const bool BATCH_PATHS_REGISTERED = []()
+{
+    for (collision::SweepBatchPath path : {collision::SweepBatchPath::Scalar, collision::SweepBatchPath::Sse2,
+                                           collision::SweepBatchPath::Avx2})
+    {
+        if (collision::isSweepBatchPathSupported(path))
+        {
+            std::string name = std::string("BM_Kernel_SweepCircleBoxes/") + collision::getSweepBatchPathName(path);
+            benchmark::RegisterBenchmark(name.c_str(), BM_Kernel_SweepCircleBoxes, path);
+        }
+    }
+    return true;
+}();
+
+void BM_GameObject_GetAABB(benchmark::State& state)
+{
+    Brick brick(100.f, 100.f, 70.f, 30.f, 3);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(brick.getAABB());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GameObject_GetAABB);
+} // namespace
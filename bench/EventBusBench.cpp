@@ -0,0 +1,167 @@
+// Event delivery: the typed bus against the per-key std::function map the
+// InputManager used to keep, and the simulation's own events over whole games.
+#include "BenchCounters.hpp"
+#include "EventBus.hpp"
+#include "Simulation.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+constexpr int SUBSCRIBERS{4};
+
+struct KeyEvent
+{
+    std::uint32_t key{0};
+};
+
+struct Tally
+{
+    std::uint64_t sum{0};
+    std::uint32_t last{0};
+    bool ordered{true};
+
+    void onKey(const KeyEvent& event)
+    {
+        ordered = ordered && event.key >= last;
+        last = event.key;
+        sum += event.key;
+    }
+};
+
+// Old InputManager: one hash lookup per event, then type-erased calls
+void BM_Events_FunctionMap(benchmark::State& state)
+{
+    std::unordered_map<std::uint32_t, std::vector<std::function<void()>>> bindings;
+    Tally tallies[SUBSCRIBERS];
+    for (std::uint32_t key = 0; key < 64; ++key)
+    {
+        for (Tally& tally : tallies)
+        {
+            bindings[key].push_back([&tally, key]() { tally.onKey(KeyEvent{key}); });
+        }
+    }
+
+    std::uint32_t events = static_cast<std::uint32_t>(state.range(0));
+    for (auto _ : state)
+    {
+        for (std::uint32_t i = 0; i < events; ++i)
+        {
+            auto it = bindings.find(i & 63u);
+            if (it != bindings.end())
+            {
+                for (const auto& callback : it->second)
+                {
+                    callback();
+                }
+            }
+        }
+    }
+    benchmark::DoNotOptimize(tallies[0].sum);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// A tick's worth of events published, then dispatched in one batch. Nothing
+// may allocate, and every subscriber must see every event in publish order.
+void BM_Events_Bus(benchmark::State& state)
+{
+    EventBus<KeyEvent> bus;
+    Tally tallies[SUBSCRIBERS];
+    for (Tally& tally : tallies)
+    {
+        bus.subscribe<KeyEvent, &Tally::onKey>(tally);
+    }
+
+    std::uint32_t events = static_cast<std::uint32_t>(state.range(0));
+    std::uint64_t expected = 0;
+    std::size_t before = bench::allocationCount();
+    for (auto _ : state)
+    {
+        for (Tally& tally : tallies)
+        {
+            tally.last = 0;
+        }
+        for (std::uint32_t i = 0; i < events; ++i)
+        {
+            bus.publish(KeyEvent{i});
+            expected += i;
+        }
+        bus.dispatch();
+    }
+    bench::requireNoAllocations(state, before);
+
+    for (const Tally& tally : tallies)
+    {
+        if (tally.sum != expected || !tally.ordered)
+        {
+            state.SkipWithError("an event was lost, repeated or delivered out of order");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Full games on the default wall with listeners on every simulation event:
+// their tallies must agree with the simulation's own state at every step
+struct GameListener
+{
+    int bricks{0};
+    int points{0};
+    int score{0};
+    int livesLost{0};
+
+    void onBrickDestroyed(const BrickDestroyedEvent& event)
+    {
+        ++bricks;
+        points += event.points;
+    }
+    void onScoreChanged(const ScoreChangedEvent& event) { score = event.score; }
+    void onLifeLost(const LifeLostEvent&) { ++livesLost; }
+};
+
+void BM_Events_SimulationGames(benchmark::State& state)
+{
+    Simulation simulation;
+    GameListener listener;
+    SimulationEvents& events = simulation.getEvents();
+    events.subscribe<BrickDestroyedEvent, &GameListener::onBrickDestroyed>(listener);
+    events.subscribe<ScoreChangedEvent, &GameListener::onScoreChanged>(listener);
+    events.subscribe<LifeLostEvent, &GameListener::onLifeLost>(listener);
+
+    SimulationInput input;
+    std::uint64_t ticks = 0;
+    bool consistent = true;
+    for (auto _ : state)
+    {
+        if (simulation.getState() != Simulation::PLAYING)
+        {
+            simulation.startGame();
+            listener = GameListener();
+        }
+
+        input.paddleTargetX = simulation.getBalls().empty() ? 0.f : simulation.getBalls().getPosition(0).x + 20.f;
+        input.launch = !simulation.isBallLaunched();
+        input.multiBall = (++ticks % 1200 == 600) ? 3 : 0;
+        simulation.step(input);
+
+        int destroyed = static_cast<int>(simulation.getBricks().size() - simulation.getBricks().countAlive());
+        consistent = consistent && listener.bricks == destroyed && listener.points == simulation.getScore() &&
+                     listener.score == simulation.getScore() &&
+                     listener.livesLost == Simulation::INITIAL_LIVES - simulation.getLives() &&
+                     events.getQueuedCount<BrickDestroyedEvent>() == 0;
+    }
+
+    if (!consistent)
+    {
+        state.SkipWithError("event tallies differ from the simulation state");
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_Events_FunctionMap)->ArgName("events")->Arg(16)->Arg(256);
+BENCHMARK(BM_Events_Bus)->ArgName("events")->Arg(16)->Arg(256);
+BENCHMARK(BM_Events_SimulationGames)->Unit(benchmark::kMicrosecond);
+} // namespace
@@ -0,0 +1,66 @@
+// Per-frame cost of the HUD and playfield vertex updates, with the heap
+// allocations they make (the tests require none after the first frame).
+#include "BatchRenderer.hpp"
+#include "BenchCounters.hpp"
+#include "Hud.hpp"
+#include "Simulation.hpp"
+#include <benchmark/benchmark.h>
+
+namespace
+{
+using bench::reportAllocations;
+
+void BM_Hud_SteadyFrame(benchmark::State& state)
+{
+    Hud hud;
+    hud.update(Simulation::PLAYING, 3, 120); // First frame lays everything out
+
+    std::size_t before = bench::allocationCount();
+    for (auto _ : state)
+    {
+        hud.update(Simulation::PLAYING, 3, 120);
+        benchmark::DoNotOptimize(hud.getLastRebuiltTextCount());
+    }
+    reportAllocations(state, before);
+}
+BENCHMARK(BM_Hud_SteadyFrame);
+
+// Score changes every frame: the cost of re-laying out one text
+void BM_Hud_ScoreChange(benchmark::State& state)
+{
+    Hud hud;
+    int score = 0;
+    hud.update(Simulation::PLAYING, 3, score);
+
+    std::size_t before = bench::allocationCount();
+    for (auto _ : state)
+    {
+        score += 10;
+        hud.update(Simulation::PLAYING, 3, score);
+        benchmark::DoNotOptimize(hud.getLastRebuiltTextCount());
+    }
+    reportAllocations(state, before);
+}
+BENCHMARK(BM_Hud_ScoreChange);
+
+// Everything the game prepares for a frame of a resting game: HUD and vertices
+void BM_Frame_SteadyDrawPrep(benchmark::State& state)
+{
+    Hud hud;
+    Simulation simulation;
+    simulation.startGame();
+    BatchRenderer renderer;
+    renderer.update(simulation);
+    hud.update(simulation.getState(), simulation.getLives(), simulation.getScore());
+
+    std::size_t before = bench::allocationCount();
+    for (auto _ : state)
+    {
+        renderer.update(simulation, 0.5f);
+        hud.update(simulation.getState(), simulation.getLives(), simulation.getScore());
+        benchmark::DoNotOptimize(renderer.getVertexCount());
+    }
+    reportAllocations(state, before);
+}
+BENCHMARK(BM_Frame_SteadyDrawPrep);
+} // namespace
@@ -0,0 +1,329 @@
+// Simulation snapshots for rollback and rewinding: the cost of a save plus a
+// restore on large levels, rollback-and-resimulate over whole games, which
+// must reproduce every state bit for bit and never allocate, and versus
+// matches between two rollback peers over a slow, lossy link, which must end
+// on the same state.
+#include "BenchCounters.hpp"
+#include "BenchLayouts.hpp"
+#include "LinkConditioner.hpp"
+#include "Simulation.hpp"
+#include "VersusSession.hpp"
+#include <array>
+#include <benchmark/benchmark.h>
+#include <limits>
+
+namespace
+{
+// Paddle under the first ball, relaunch after a lost life, bursts of balls now and then
+SimulationInput followBall(const Simulation& simulation, int burst = 3, float offset = 20.f)
+{
+    SimulationInput input;
+    const BallField& balls = simulation.getBalls();
+    input.paddleTargetX = balls.empty() ? Simulation::WINDOW_WIDTH / 2.f : balls.getPosition(0).x + offset;
+    input.launch = !simulation.isBallLaunched();
+    input.multiBall = simulation.getTick() % 600 == 300 ? burst : 0;
+    return input;
+}
+
+// Save, one step, restore: the step is not timed. Restoring must bring back
+// the saved state exactly, and neither side may allocate.
+void BM_Simulation_SaveRestore(benchmark::State& state)
+{
+    BrickField layout = bench::makeBrickLayout(static_cast<int>(state.range(0)), 3);
+    Simulation simulation;
+    simulation.startGame(layout);
+    SimulationInput input;
+    input.launch = true;
+    input.multiBall = static_cast<int>(state.range(1)) - 1;
+    simulation.step(input);
+    for (int i = 0; i < 240 && simulation.getState() == Simulation::PLAYING; ++i)
+    {
+        simulation.step(followBall(simulation));
+    }
+
+    SimulationSnapshot snapshot;
+    simulation.saveState(snapshot);
+    bool exact = true;
+    std::size_t before = bench::allocationCount();
+    for (auto _ : state)
+    {
+        simulation.saveState(snapshot);
+
+        state.PauseTiming();
+        std::uint64_t saved = simulation.computeStateHash();
+        simulation.step(followBall(simulation));
+        state.ResumeTiming();
+
+        bool restored = simulation.restoreState(snapshot);
+
+        state.PauseTiming();
+        exact = exact && restored && simulation.computeStateHash() == saved;
+        state.ResumeTiming();
+    }
+    bench::requireNoAllocations(state, before);
+
+    if (!exact)
+    {
+        state.SkipWithError("restored state differs from the saved one");
+    }
+    state.counters["bytes"] = static_cast<double>(snapshot.getByteSize());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Simulation_SaveRestore)
+    ->ArgNames({"bricks", "balls"})
+    ->ArgsProduct({{1000, 10000, 100000}, {1, 64}})
+    ->Unit(benchmark::kMicrosecond);
+
+// Rollback netcode pattern: a snapshot every tick in a ring; every ROLLBACK
+// ticks, go back to the oldest one and simulate the same inputs again. The
+// replayed states must hash the same as the first time, through brick
+// deaths, lost lives and grid compaction (bricks coming back into the grid).
+void BM_Simulation_Rollback(benchmark::State& state)
+{
+    constexpr std::size_t ROLLBACK{8};
+    BrickField layout = bench::makeBrickLayout(static_cast<int>(state.range(0)), 1);
+    Simulation simulation;
+    std::array<SimulationSnapshot, ROLLBACK> snapshots;
+    std::array<SimulationInput, ROLLBACK> inputs;
+    std::array<std::uint64_t, ROLLBACK> hashes;
+    std::size_t filled = 0;
+    bool exact = true;
+
+    for (auto _ : state)
+    {
+        if (simulation.getState() != Simulation::PLAYING)
+        {
+            simulation.startGame(layout);
+            filled = 0;
+        }
+
+        simulation.saveState(snapshots[filled]);
+        inputs[filled] = followBall(simulation, 15); // Enough balls to clear most of the level
+        simulation.step(inputs[filled]);
+        hashes[filled] = simulation.computeStateHash();
+        if (++filled < ROLLBACK)
+        {
+            continue;
+        }
+
+        exact = exact && simulation.restoreState(snapshots[0]);
+        for (std::size_t i = 0; i < ROLLBACK; ++i)
+        {
+            simulation.step(inputs[i]);
+            exact = exact && simulation.computeStateHash() == hashes[i];
+        }
+        filled = 0;
+    }
+
+    if (!exact)
+    {
+        state.SkipWithError("resimulated states differ from the first run");
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Simulation_Rollback)->ArgName("bricks")->Arg(50)->Arg(1000)->Unit(benchmark::kMicrosecond);
+
+// Many long rollbacks to the same snapshot, each down a different path: far
+// more brick hits in total than the change log was reserved for. Restoring
+// cuts the log back, so nothing may allocate. A copy synced partway through
+// each path, as the renderer's is, must still match the bricks: the log has
+// been rewound and grown back since its last sync.
+void BM_Simulation_RollbackWithoutAllocations(benchmark::State& state)
+{
+    constexpr int RESIMULATED_TICKS{240};
+    constexpr int SYNC_TICK{60};
+    BrickField layout = bench::makeBrickLayout(100, 3);
+    Simulation simulation;
+    simulation.startGame(layout);
+    SimulationInput input;
+    input.launch = true;
+    input.multiBall = 15;
+    simulation.step(input);
+    // Save with the balls up among the bricks
+    for (int i = 0; i < 60 && simulation.getState() == Simulation::PLAYING; ++i)
+    {
+        simulation.step(followBall(simulation, 0));
+    }
+
+    SimulationSnapshot snapshot;
+    simulation.saveState(snapshot);
+    std::uint64_t savedHash = simulation.computeStateHash();
+    BrickField mirror;
+    mirror.syncFrom(simulation.getBricks());
+    std::size_t reserved = simulation.getBricks().getChangeLog().capacity();
+    std::uint64_t changes = 0;
+    int burst = 0;
+    bool exact = true;
+    bool synced = true;
+
+    std::size_t before = bench::allocationCount();
+    for (auto _ : state)
+    {
+        // A different burst right away sends every path its own way
+        burst = burst % 4 + 1;
+        for (int i = 1; i <= RESIMULATED_TICKS && simulation.getState() == Simulation::PLAYING; ++i)
+        {
+            input = followBall(simulation, 0);
+            input.multiBall = i == 1 ? burst : 0;
+            simulation.step(input);
+            if (i != SYNC_TICK)
+            {
+                continue;
+            }
+            const BrickField& bricks = simulation.getBricks();
+            mirror.syncFrom(bricks);
+            for (std::size_t brick = 0; brick < bricks.size(); ++brick)
+            {
+                synced = synced && mirror.getHealth(brick) == bricks.getHealth(brick) &&
+                         mirror.isAlive(brick) == bricks.isAlive(brick);
+            }
+        }
+        changes += simulation.getBricks().getChangeLog().size();
+
+        exact = exact && simulation.restoreState(snapshot) && simulation.computeStateHash() == savedHash;
+    }
+    bench::requireNoAllocations(state, before);
+
+    if (!exact)
+    {
+        state.SkipWithError("restored state differs from the saved one");
+    }
+    else if (!synced)
+    {
+        state.SkipWithError("synced copy differs from the rewound bricks");
+    }
+    else if (changes <= reserved)
+    {
+        state.SkipWithError("rollbacks never logged more changes than were reserved");
+    }
+    state.counters["changes"] = static_cast<double>(changes);
+    state.counters["reserved"] = static_cast<double>(reserved);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Simulation_RollbackWithoutAllocations)->Iterations(2000)->Unit(benchmark::kMicrosecond);
+
+// One side of a versus match, with the link carrying its packets to the other
+struct VersusPeer
+{
+    explicit VersusPeer(int player)
+        : session(fields[0], fields[1], player)
+    {
+    }
+
+    std::array<Simulation, 2> fields;
+    VersusSession session;
+    LinkConditioner outgoing;
+};
+
+// Two peers in one process, one frame per iteration, on a clock of their own:
+// every frame each peer reads what has arrived, simulates a tick if it may and
+// sends a packet. Packets take `latency` ms one way, plus up to a quarter of
+// that in jitter, and `loss` percent never arrive. Matches are replayed until
+// the time runs out; each must end on the same state on both peers.
+void BM_Versus(benchmark::State& state)
+{
+    constexpr std::uint64_t MAX_TICKS{60 * Simulation::STEPS_PER_SECOND};
+    constexpr std::int64_t FRAME_MICROSECONDS{1000000 / Simulation::STEPS_PER_SECOND};
+    BrickField layout = bench::makeBrickLayout(100, 1);
+    std::array<VersusPeer, 2> peers{VersusPeer(0), VersusPeer(1)};
+    for (VersusPeer& peer : peers)
+    {
+        LinkConditioner::Conditions conditions;
+        conditions.latencyMilliseconds = static_cast<double>(state.range(0));
+        conditions.jitterMilliseconds = conditions.latencyMilliseconds / 4.0;
+        conditions.lossRate = static_cast<double>(state.range(1)) / 100.0;
+        conditions.seed = static_cast<std::uint32_t>(peer.session.getLocalPlayer() + 1);
+        peer.outgoing.setConditions(conditions);
+        peer.session.start(layout);
+    }
+
+    std::array<unsigned char, VersusSession::MAX_PACKET_SIZE> packet;
+    std::size_t size = 0;
+    std::int64_t now = 0;
+    std::uint64_t matches = 0;
+    std::uint64_t stalls = 0;
+    VersusSession::Stats totals;
+    bool agreed = true;
+    auto over = [](const VersusSession& session)
+    {
+        return (session.isFinished() || session.getTick() >= MAX_TICKS) && session.isSettled();
+    };
+
+    for (auto _ : state)
+    {
+        now += FRAME_MICROSECONDS;
+        for (int player = 0; player < 2; ++player)
+        {
+            VersusPeer& peer = peers[player];
+            while (peers[1 - player].outgoing.pop(now, packet.data(), packet.size(), size))
+            {
+                peer.session.readPacket(packet.data(), size);
+            }
+
+            peer.session.settle();
+            if (!over(peer.session) && peer.session.getTick() < MAX_TICKS)
+            {
+                if (peer.session.canAdvance())
+                {
+                    const Simulation& field = peer.fields[player];
+                    peer.session.advance(followBall(field, 3, player == 0 ? 20.f : -25.f));
+                }
+                else
+                {
+                    ++stalls;
+                }
+            }
+            size = peer.session.writePacket(packet.data(), packet.size());
+            peer.outgoing.push(packet.data(), size, now);
+        }
+
+        if (!over(peers[0].session) || !over(peers[1].session))
+        {
+            continue;
+        }
+
+        // Match over on both sides: compare, then start again on empty links
+        agreed = agreed && peers[0].session.computeStateHash() == peers[1].session.computeStateHash();
+        ++matches;
+        for (VersusPeer& peer : peers)
+        {
+            const VersusSession::Stats& stats = peer.session.getStats();
+            totals.ticks += stats.ticks;
+            totals.rollbacks += stats.rollbacks;
+            totals.resimulatedTicks += stats.resimulatedTicks;
+            totals.maxRollbackDepth = std::max(totals.maxRollbackDepth, stats.maxRollbackDepth);
+            totals.totalResimulationMicroseconds += stats.totalResimulationMicroseconds;
+            totals.maxResimulationMicroseconds =
+                std::max(totals.maxResimulationMicroseconds, stats.maxResimulationMicroseconds);
+
+            while (peer.outgoing.pop(std::numeric_limits<std::int64_t>::max(), packet.data(), packet.size(), size))
+            {
+            }
+            peer.session.start(layout);
+        }
+    }
+
+    if (!agreed)
+    {
+        state.SkipWithError("peers ended a match on different states");
+    }
+    else if (matches == 0)
+    {
+        state.SkipWithError("no match ended on both peers (desync or stall)");
+    }
+    double rollbacks = static_cast<double>(std::max<std::uint64_t>(totals.rollbacks, 1));
+    state.counters["matches"] = static_cast<double>(matches);
+    state.counters["rollback_rate"] = static_cast<double>(totals.rollbacks) / std::max<double>(totals.ticks, 1.0);
+    state.counters["mean_depth"] = static_cast<double>(totals.resimulatedTicks) / rollbacks;
+    state.counters["max_depth"] = static_cast<double>(totals.maxRollbackDepth);
+    state.counters["resim_us"] = totals.totalResimulationMicroseconds / rollbacks;
+    state.counters["max_resim_us"] = totals.maxResimulationMicroseconds;
+    state.counters["stalls"] = static_cast<double>(stalls);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Versus)
+    ->ArgNames({"latency", "loss"})
+    ->ArgsProduct({{0, 30, 80}, {0, 10}})
+    ->Iterations(20000)
+    ->Unit(benchmark::kMicrosecond);
+} // namespace
@@ -0,0 +1,92 @@
+// Cost of one full fixed simulation step (paddle, balls, brick collision, rules)
+// over a range of brick and ball counts.
+#include "BenchCounters.hpp"
+#include "BenchLayouts.hpp"
+#include "Simulation.hpp"
+#include <benchmark/benchmark.h>
+
+namespace
+{
+// Bricks are unbreakable in practice, so the field stays the same size throughout
+constexpr int BENCH_BRICK_HEALTH{1000000};
+
+void startBenchGame(Simulation& simulation, const BrickField& layout, int balls)
+{
+    simulation.startGame(layout);
+
+    SimulationInput input;
+    input.paddleTargetX = Simulation::WINDOW_WIDTH / 2.f;
+    input.launch = true;
+    input.multiBall = balls - 1;
+    simulation.step(input);
+}
+
+void BM_Simulation_Step(benchmark::State& state)
+{
+    BrickField layout = bench::makeBrickLayout(static_cast<int>(state.range(0)), BENCH_BRICK_HEALTH);
+    int balls = static_cast<int>(state.range(1));
+
+    Simulation simulation;
+    startBenchGame(simulation, layout, balls);
+
+    SimulationInput input;
+    for (auto _ : state)
+    {
+        // Balls drain out of the bottom over time; restart once half are gone
+        if (simulation.getState() != Simulation::PLAYING ||
+            simulation.getBalls().size() < static_cast<std::size_t>(balls + 1) / 2)
+        {
+            state.PauseTiming();
+            startBenchGame(simulation, layout, balls);
+            state.ResumeTiming();
+        }
+
+        input.paddleTargetX = simulation.getBalls().empty() ? 0.f : simulation.getBalls().getPosition(0).x;
+        simulation.step(input);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Simulation_Step)
+    ->ArgNames({"bricks", "balls"})
+    ->ArgsProduct({{50, 1000, 10000, 100000}, {1, 64, 1024}})
+    ->Unit(benchmark::kMicrosecond);
+// A whole level on the default wall, start to finish, restarted whenever it
+// ends, with multi-ball bursts, brick hits and lost lives. Reports allocations
+// after the first game (the tests require none).
+void BM_Simulation_LevelWithoutAllocations(benchmark::State& state)
+{
+    Simulation simulation;
+    SimulationInput input;
+    std::uint64_t ticks = 0;
+
+    auto playTick = [&]()
+    {
+        if (simulation.getState() != Simulation::PLAYING)
+        {
+            simulation.startGame();
+        }
+
+        // Follow the first ball, relaunch after a lost life, burst every ten seconds
+        input.paddleTargetX = simulation.getBalls().empty() ? 0.f : simulation.getBalls().getPosition(0).x + 20.f;
+        input.launch = !simulation.isBallLaunched();
+        input.multiBall = (++ticks % 1200 == 600) ? 3 : 0;
+        simulation.step(input);
+    };
+
+    // First game sizes every buffer
+    simulation.startGame();
+    while (simulation.getState() == Simulation::PLAYING)
+    {
+        playTick();
+    }
+
+    std::size_t before = bench::allocationCount();
+    for (auto _ : state)
+    {
+        playTick();
+    }
+    bench::reportAllocations(state, before);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Simulation_LevelWithoutAllocations)->Unit(benchmark::kMicrosecond);
+} // namespace
@@ -0,0 +1,137 @@
+// Handoff of render snapshots from the simulation thread to the render thread.
+// The tests check what is handed over; these measure what it costs.
+#include "BenchCounters.hpp"
+#include "BenchLayouts.hpp"
+#include "RenderSnapshot.hpp"
+#include "Simulation.hpp"
+#include "SimulationThread.hpp"
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+// Steps a game with an AI paddle that follows the first ball; restarts it when it ends
+void stepFollowingBall(Simulation& simulation, const BrickField& layout)
+{
+    if (simulation.getState() != Simulation::PLAYING)
+    {
+        simulation.startGame(layout);
+    }
+
+    SimulationInput input;
+    const BallField& balls = simulation.getBalls();
+    input.paddleTargetX = balls.empty() ? Simulation::WINDOW_WIDTH / 2.f : balls.getPosition(0).x;
+    input.launch = !simulation.isBallLaunched();
+    input.multiBall = simulation.getTick() % 240 == 0 ? 2 : 0;
+    simulation.step(input);
+}
+
+// One capture per step of a running level, with the allocations made after
+// the first few (which size the snapshot)
+void BM_Snapshot_Capture(benchmark::State& state)
+{
+    BrickField layout = bench::makeBrickLayout(static_cast<int>(state.range(0)), 3);
+    Simulation simulation;
+    RenderSnapshot snapshot;
+    for (int i = 0; i < 3; ++i)
+    {
+        stepFollowingBall(simulation, layout);
+        snapshot.capture(simulation, 0);
+    }
+
+    std::size_t before = bench::allocationCount();
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::uint32_t generation = simulation.getBricks().getGeneration();
+        stepFollowingBall(simulation, layout);
+        bool restarted = simulation.getBricks().getGeneration() != generation;
+        state.ResumeTiming();
+
+        // A restart copies the whole field once, which allocates the first time
+        if (restarted)
+        {
+            snapshot.capture(simulation, 0);
+            before = bench::allocationCount();
+            continue;
+        }
+        snapshot.capture(simulation, 0);
+        benchmark::DoNotOptimize(snapshot.bricks.size());
+    }
+    bench::reportAllocations(state, before);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Snapshot_Capture)->ArgName("bricks")->Arg(50)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+// A producer steps and publishes as fast as it can while the consumer (the
+// benchmark loop) acquires; counts how many acquires found a new snapshot.
+void BM_Snapshot_Handoff(benchmark::State& state)
+{
+    BrickField layout = bench::makeBrickLayout(1000, 3);
+    Simulation simulation;
+    SnapshotBuffer buffer;
+    std::atomic<bool> running{true};
+
+    std::thread producer([&]()
+    {
+        std::int64_t tickEnd = 0;
+        while (running.load(std::memory_order_relaxed))
+        {
+            stepFollowingBall(simulation, layout);
+            buffer.beginWrite().capture(simulation, ++tickEnd);
+            buffer.publish();
+        }
+    });
+
+    std::int64_t lastTickEnd = 0;
+    std::int64_t fresh = 0;
+    for (auto _ : state)
+    {
+        const RenderSnapshot& snapshot = buffer.acquire();
+        fresh += snapshot.tickEndMicroseconds != lastTickEnd;
+        lastTickEnd = snapshot.tickEndMicroseconds;
+        benchmark::DoNotOptimize(snapshot.score);
+    }
+
+    running.store(false);
+    producer.join();
+    state.counters["fresh"] = benchmark::Counter(static_cast<double>(fresh), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_Snapshot_Handoff)->Unit(benchmark::kNanosecond);
+
+// Latency from posting a level start to a snapshot that shows it, with the
+// simulation thread running at its real fixed rate: at most about one step.
+void BM_SimulationThread_PostToSnapshot(benchmark::State& state)
+{
+    BrickField layout = bench::makeBrickLayout(1000);
+    Simulation simulation;
+    SimulationThread thread(simulation, [&simulation](std::int64_t)
+    {
+        if (simulation.getState() == Simulation::PLAYING)
+        {
+            simulation.step(SimulationInput());
+        }
+    });
+    thread.start();
+
+    for (auto _ : state)
+    {
+        thread.post([&simulation, &layout]() { simulation.startGame(layout); });
+        while (!thread.isCurrent(thread.acquireSnapshot()))
+        {
+            std::this_thread::yield();
+        }
+
+        thread.post([&simulation]() { simulation.returnToMenu(); });
+        while (!thread.isCurrent(thread.acquireSnapshot()))
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    thread.stop();
+}
+BENCHMARK(BM_SimulationThread_PostToSnapshot)->Iterations(20)->Unit(benchmark::kMillisecond);
+} // namespace
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "BrickField.hpp"
+#include "LevelPack.hpp"
+#include "TextureAtlas.hpp"
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Result of an asynchronous load. Polling never blocks, so the main loop can
+// keep rendering while the asset is decoded.
+template <typename T>
+class AssetHandle
+{
+public:
+    AssetHandle() = default;
+    explicit AssetHandle(std::future<std::unique_ptr<T>> future)
+        : m_future(std::move(future))
+    {
+    }
+
+    // A load was requested (ready or not)
+    bool isValid() const { return m_resolved || m_future.valid(); }
+
+    // The load has finished, successfully or not
+    bool isReady()
+    {
+        return m_resolved ||
+               (m_future.valid() && m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+    }
+
+    // The asset, waiting for it if needed; nullptr if loading failed or the
+    // loader shut down first
+    T* get()
+    {
+        if (!m_resolved && m_future.valid())
+        {
+            try
+            {
+                m_asset = m_future.get();
+            }
+            catch (const std::future_error&)
+            {
+                m_asset.reset();
+            }
+            m_resolved = true;
+        }
+        return m_asset.get();
+    }
+
+private:
+    std::future<std::unique_ptr<T>> m_future;
+    std::unique_ptr<T> m_asset;
+    bool m_resolved{false};
+};
+
+// Single worker thread decoding files in request order. Only CPU-side work
+// happens here (image decoding, font parsing, level unpacking); turning an
+// sf::Image into an sf::Texture has to be done on the thread owning the window.
+class AssetLoader
+{
+public:
+    AssetLoader();
+    ~AssetLoader();
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // First of the candidate paths that loads
+    AssetHandle<sf::Font> loadFont(std::vector<std::string> candidatePaths);
+    AssetHandle<sf::Image> loadImage(const std::string& path);
+    // Decode the three sprite images and pack them into one atlas image
+    AssetHandle<TextureAtlas> loadAtlas(const std::string& ballPath, const std::string& brickPath,
+                                        const std::string& paddlePath);
+
+    // Bricks of a pack level, laid out for the playfield. The pack must stay
+    // open until the handle is ready.
+    AssetHandle<BrickField> loadLevel(const LevelPack& pack, std::size_t index, float playfieldWidth);
+
+private:
+    std::thread m_worker;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<std::function<void()>> m_jobs;
+    bool m_stopping{false};
+
+    void run();
+
+    template <typename T>
+    AssetHandle<T> enqueue(std::function<std::unique_ptr<T>()> load);
+};
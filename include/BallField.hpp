@@ -0,0 +1,57 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Structure-of-arrays storage for every ball in play (all share one radius).
+// Positions are the top-left corner of each ball's bounding box, as in Ball.
+class BallField
+{
+public:
+    explicit BallField(float radius);
+
+    void clear();
+    void reserve(std::size_t count);
+
+    // Append a ball and return its index
+    std::size_t spawn(const sf::Vector2f& position, const sf::Vector2f& velocity, bool gravityEnabled);
+
+    // Swap-and-pop: the last ball takes the removed ball's index
+    void remove(std::size_t index);
+
+    std::size_t size() const { return m_x.size(); }
+    bool empty() const { return m_x.empty(); }
+    float getRadius() const { return m_radius; }
+
+    sf::Vector2f getPosition(std::size_t index) const { return sf::Vector2f(m_x[index], m_y[index]); }
+    sf::Vector2f getPreviousPosition(std::size_t index) const { return sf::Vector2f(m_previousX[index], m_previousY[index]); }
+    sf::Vector2f getVelocity(std::size_t index) const { return sf::Vector2f(m_vx[index], m_vy[index]); }
+    bool isGravityEnabled(std::size_t index) const { return m_gravity[index] != 0; }
+
+    void setPosition(std::size_t index, const sf::Vector2f& position);
+    void setVelocity(std::size_t index, const sf::Vector2f& velocity);
+    void setGravityEnabled(std::size_t index, bool enabled) { m_gravity[index] = enabled ? 1 : 0; }
+
+    // Remember the current positions as the start of the step (for render interpolation)
+    void storePreviousPositions();
+
+    // Every column packed one after the other, for simulation snapshots
+    static constexpr std::size_t BYTES_PER_BALL{6 * sizeof(float) + sizeof(std::uint8_t)};
+    std::size_t getStateSize() const { return size() * BYTES_PER_BALL; }
+    void saveState(unsigned char* out) const;
+    // Replace every ball with `count` balls written by saveState (no allocation
+    // up to the reserved count)
+    void restoreState(const unsigned char* in, std::size_t count);
+
+private:
+    float m_radius;
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+    std::vector<float> m_vx;
+    std::vector<float> m_vy;
+    std::vector<float> m_previousX;
+    std::vector<float> m_previousY;
+    std::vector<std::uint8_t> m_gravity;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "RenderSnapshot.hpp"
+#include "Simulation.hpp"
+#include "TextureAtlas.hpp"
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Draws the whole playfield (bricks, paddle, balls) with a single vertex array.
+// Brick vertices persist between frames and are only rewritten for bricks whose
+// health changed; the paddle and balls sit in a tail rewritten every frame.
+// Until an atlas is set everything is drawn in flat colours.
+class BatchRenderer : public sf::Drawable
+{
+public:
+    static constexpr std::size_t VERTICES_PER_RECT{6};   // Two triangles
+    static constexpr std::size_t VERTICES_PER_BRICK{12}; // Outline rectangle + fill rectangle
+    static constexpr std::size_t BALL_SEGMENTS{30};      // Same point count as sf::CircleShape
+
+    BatchRenderer();
+
+    // Bring the vertices in line with the simulation state. Moving objects are
+    // drawn at alpha between their previous and current step positions.
+    void update(const Simulation& simulation, float alpha = 1.f);
+    // Same, from a snapshot published by the simulation thread
+    void update(const RenderSnapshot& snapshot, float alpha = 1.f);
+
+    // Texture the playfield from an atlas uploaded into `texture` (which must
+    // outlive the renderer); the atlas itself is not kept
+    void setAtlas(const sf::Texture& texture, const TextureAtlas& atlas);
+
+    // For headless checks. Brick i owns vertices [i * VERTICES_PER_BRICK, (i + 1) * VERTICES_PER_BRICK);
+    // a destroyed brick's are collapsed to transparent points.
+    std::size_t getVertexCount() const { return m_vertices.getVertexCount(); }
+    const sf::Vertex& getVertex(std::size_t index) const { return m_vertices[index]; }
+    // Bricks written by the last update(): all of them after a rebuild, else those logged since
+    std::size_t getLastRebuiltBrickCount() const { return m_lastRebuiltBricks; }
+
+protected:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+private:
+    sf::VertexArray m_vertices;
+    std::size_t m_brickCount{0};
+    std::uint32_t m_brickGeneration{0};
+    std::uint32_t m_brickRewinds{0};
+    std::size_t m_changeLogCursor{0};
+    std::size_t m_lastRebuiltBricks{0};
+    std::vector<sf::Vector2f> m_circle; // Unit circle points for the ball fan
+
+    const sf::Texture* m_texture{nullptr};
+    std::array<sf::FloatRect, TextureAtlas::SPRITE_COUNT> m_textureRects{}; // All empty without an atlas
+    bool m_bricksStale{false};
+
+    const sf::FloatRect& textureRect(AtlasSprite sprite) const
+    {
+        return m_textureRects[static_cast<std::size_t>(sprite)];
+    }
+
+    void update(const BrickField& bricks, const BallField& balls, const sf::FloatRect& previousPaddle,
+                const sf::FloatRect& paddle, float alpha);
+    void rebuildAllBricks(const BrickField& bricks);
+    void writeBrick(const BrickField& bricks, std::size_t index);
+    void writeRect(std::size_t first, const sf::FloatRect& rect, const sf::Color& color,
+                   const sf::FloatRect& textureRect);
+    void writePaddle(std::size_t first, const sf::FloatRect& previous, const sf::FloatRect& current, float alpha);
+    void writeBalls(std::size_t first, const BallField& balls, float alpha);
+    void collapse(std::size_t first, std::size_t count);
+};
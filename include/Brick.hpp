@@ -6,6 +6,15 @@
 class Brick : public GameObject
 {
 public:
+    // Look of a damaged brick: one colour (and atlas sprite) per state
+    enum HealthState
+    {
+        LOW_HEALTH,
+        MEDIUM_HEALTH,
+        HIGH_HEALTH,
+        HEALTH_STATE_COUNT
+    };
+
     Brick(float x, float y, float width, float height, int maxHealth = 1);
 
     int getHealth() const { return m_health; }
@@ -18,6 +27,11 @@ public:
     void update(float deltaTime) override;
     void draw(sf::RenderWindow& window) const override;
 
+    // Health-based fill colour, shared with renderers drawing a BrickField
+    static sf::Color colorForHealth(int health, int maxHealth);
+    static HealthState healthState(int health, int maxHealth);
+    static sf::Color colorForState(HealthState state);
+
 private:
     int m_health;
     int m_maxHealth;
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Structure-of-arrays storage for all bricks of a level.
+// Bricks are addressed by a stable index; destroyed bricks stay in place and
+// are only cleared from the alive bitmask, so indices held by the collision
+// grid or the renderer never move during a level. A live count kept with the
+// bitmask makes destroying a brick and checking for victory O(1).
+class BrickField
+{
+public:
+    void clear();
+    void reserve(std::size_t count);
+
+    // Append a brick and return its index
+    std::size_t add(float x, float y, float width, float height, int maxHealth = 1);
+
+    std::size_t size() const { return m_x.size(); }
+    bool empty() const { return m_x.empty(); }
+
+    bool isAlive(std::size_t index) const { return (m_alive[index >> 6] >> (index & 63)) & 1u; }
+    bool allDestroyed() const { return m_aliveCount == 0; }
+    std::size_t countAlive() const { return m_aliveCount; }
+
+    // Returns true if this hit destroyed the brick
+    bool takeDamage(std::size_t index, int damage = 1);
+    void destroy(std::size_t index);
+
+    // Every health change appends the brick index here; readers remember how far
+    // they have consumed. The log restarts (and the generation changes) on clear(),
+    // and shrinks (and the rewind count changes) on rewindTo().
+    const std::vector<std::uint32_t>& getChangeLog() const { return m_changeLog; }
+    // Put every brick back to its health from when the log was `changeCount`
+    // entries long, and cut the log back to that length, so rolling back never
+    // grows it. Readers see the new rewind count and resync in full. Positions
+    // up to `changeCount` stay valid to rewind to; later ones no longer are.
+    // Returns whether any brick came back to life.
+    bool rewindTo(std::size_t changeCount);
+    std::uint32_t getRewindCount() const { return m_rewinds; }
+    // Make room for every entry the current bricks can still log, so hits never allocate.
+    // Health above the level format's maximum (15) only counts up to it.
+    void reserveChangeLog();
+    std::uint32_t getGeneration() const { return m_generation; }
+
+    // Make this copy equal to `source`. A copy of the same level only replays the
+    // bricks logged since its last sync; anything else is copied in full.
+    void syncFrom(const BrickField& source);
+
+    int getHealth(std::size_t index) const { return m_health[index]; }
+    int getMaxHealth(std::size_t index) const { return m_maxHealth[index]; }
+    sf::FloatRect getAABB(std::size_t index) const
+    {
+        return sf::FloatRect(m_x[index], m_y[index], m_width[index], m_height[index]);
+    }
+
+    // Raw columns for tight loops
+    const float* xData() const { return m_x.data(); }
+    const float* yData() const { return m_y.data(); }
+    const float* widthData() const { return m_width.data(); }
+    const float* heightData() const { return m_height.data(); }
+    const std::int32_t* healthData() const { return m_health.data(); }
+    const std::uint64_t* aliveData() const { return m_alive.data(); }
+    std::size_t aliveWordCount() const { return m_alive.size(); }
+
+private:
+    std::vector<float> m_x;
+    std::vector<float> m_y;
+    std::vector<float> m_width;
+    std::vector<float> m_height;
+    std::vector<std::int32_t> m_health;
+    std::vector<std::int32_t> m_maxHealth;
+    std::vector<std::uint64_t> m_alive; // One bit per brick, 64 bricks per word
+    std::size_t m_aliveCount{0};        // Set bits of m_alive
+    std::vector<std::uint32_t> m_changeLog;
+    std::vector<std::int32_t> m_changedFrom; // Health before each logged change, for rewindTo()
+    std::uint32_t m_generation{0};
+    std::uint32_t m_rewinds{0};
+
+    void logChange(std::size_t index, std::int32_t previousHealth)
+    {
+        m_changeLog.push_back(static_cast<std::uint32_t>(index));
+        m_changedFrom.push_back(previousHealth);
+    }
+
+    // Only called on a live brick
+    void markDead(std::size_t index)
+    {
+        m_alive[index >> 6] &= ~(std::uint64_t{1} << (index & 63));
+        --m_aliveCount;
+    }
+    // Only called on a dead brick
+    void markAlive(std::size_t index)
+    {
+        m_alive[index >> 6] |= std::uint64_t{1} << (index & 63);
+        ++m_aliveCount;
+    }
+};
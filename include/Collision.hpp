@@ -0,0 +1,283 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Circle physics shared by Ball and BallField.
+// Positions are the top-left corner of the circle's bounding box, as in GameObject.
+namespace collision
+{
+
+// Box and circle dimensions for the kernels below. FixedBoxShape bakes them in
+// at compile time, so half-extents, grown extents and the squared radius fold
+// to constants; BoxShape holds them at runtime, for mixed box sizes.
+// Dimensions provides static constexpr float WIDTH, HEIGHT and RADIUS.
+template <typename Dimensions>
+struct FixedBoxShape
+{
+    static constexpr float width() { return Dimensions::WIDTH; }
+    static constexpr float height() { return Dimensions::HEIGHT; }
+    static constexpr float radius() { return Dimensions::RADIUS; }
+};
+
+struct BoxShape
+{
+    float boxWidth;
+    float boxHeight;
+    float circleRadius;
+
+    float width() const { return boxWidth; }
+    float height() const { return boxHeight; }
+    float radius() const { return circleRadius; }
+};
+
+// Circle vs box overlap test; the box is given by its top-left corner
+template <typename Shape>
+inline bool circleIntersectsBox(const Shape& shape, const sf::Vector2f& position, float left, float top)
+{
+    sf::Vector2f center(position.x + shape.radius(), position.y + shape.radius());
+
+    // Find closest point on the box to circle center
+    float closestX = std::max(left, std::min(center.x, left + shape.width()));
+    float closestY = std::max(top, std::min(center.y, top + shape.height()));
+
+    // Calculate distance from circle center to closest point
+    float dx = center.x - closestX;
+    float dy = center.y - closestY;
+    float distanceSquared = dx * dx + dy * dy;
+
+    return distanceSquared < (shape.radius() * shape.radius());
+}
+
+// Reflect the velocity on the axis of least penetration and push the circle out
+template <typename Shape>
+inline void resolveCircleBox(const Shape& shape, sf::Vector2f& position, sf::Vector2f& velocity, float left, float top)
+{
+    float radius = shape.radius();
+    sf::Vector2f center(position.x + radius, position.y + radius);
+    sf::Vector2f boxCenter(left + shape.width() / 2.f, top + shape.height() / 2.f);
+
+    // Determine collision side
+    float dx = center.x - boxCenter.x;
+    float dy = center.y - boxCenter.y;
+
+    float overlapX = radius + shape.width() / 2.f - std::abs(dx);
+    float overlapY = radius + shape.height() / 2.f - std::abs(dy);
+
+    if (overlapX < overlapY)
+    {
+        // Horizontal collision
+        velocity.x = -velocity.x;
+        position.x = dx > 0 ? left + shape.width() + radius : left - radius * 2.f;
+    }
+    else
+    {
+        // Vertical collision
+        velocity.y = -velocity.y;
+        position.y = dy > 0 ? top + shape.height() + radius : top - radius * 2.f;
+    }
+}
+
+// Generic versions for a runtime rectangle (Ball, mixed sizes)
+inline bool circleIntersectsAABB(const sf::Vector2f& position, float radius, const sf::FloatRect& aabb)
+{
+    return circleIntersectsBox(BoxShape{aabb.width, aabb.height, radius}, position, aabb.left, aabb.top);
+}
+
+inline void resolveCircleAABB(sf::Vector2f& position, sf::Vector2f& velocity, float radius, const sf::FloatRect& aabb)
+{
+    resolveCircleBox(BoxShape{aabb.width, aabb.height, radius}, position, velocity, aabb.left, aabb.top);
+}
+
+// Bounce off the left, right and top walls
+inline void bounceOffWalls(sf::Vector2f& position, sf::Vector2f& velocity, float radius, float windowWidth)
+{
+    float centerX = position.x + radius;
+    float centerY = position.y + radius;
+
+    // Left wall
+    if (centerX - radius <= 0.f && velocity.x < 0.f)
+    {
+        velocity.x = -velocity.x;
+        position.x = radius;
+    }
+    // Right wall
+    else if (centerX + radius >= windowWidth && velocity.x > 0.f)
+    {
+        velocity.x = -velocity.x;
+        position.x = windowWidth - radius * 2.f;
+    }
+    // Top wall
+    if (centerY - radius <= 0.f && velocity.y < 0.f)
+    {
+        velocity.y = -velocity.y;
+        position.y = radius;
+    }
+}
+
+// Result of a swept test: fraction of the displacement travelled before contact,
+// and the contact normal pointing away from the box
+struct SweepHit
+{
+    float time{1.f};
+    sf::Vector2f normal;
+    bool startedInside{false}; // Already overlapping at time 0
+};
+
+namespace detail
+{
+
+// Entry time of a moving point into a box it starts outside of
+inline bool rayEntersBox(const sf::Vector2f& start, const sf::Vector2f& displacement,
+                         float minX, float minY, float maxX, float maxY, SweepHit& hit)
+{
+    float enterX = -std::numeric_limits<float>::infinity();
+    float exitX = std::numeric_limits<float>::infinity();
+    float enterY = enterX;
+    float exitY = exitX;
+    float normalX = 0.f;
+    float normalY = 0.f;
+
+    if (displacement.x != 0.f)
+    {
+        float inverse = 1.f / displacement.x;
+        float t1 = (minX - start.x) * inverse;
+        float t2 = (maxX - start.x) * inverse;
+        enterX = std::min(t1, t2);
+        exitX = std::max(t1, t2);
+        normalX = displacement.x > 0.f ? -1.f : 1.f;
+    }
+    else if (start.x <= minX || start.x >= maxX)
+    {
+        return false;
+    }
+
+    if (displacement.y != 0.f)
+    {
+        float inverse = 1.f / displacement.y;
+        float t1 = (minY - start.y) * inverse;
+        float t2 = (maxY - start.y) * inverse;
+        enterY = std::min(t1, t2);
+        exitY = std::max(t1, t2);
+        normalY = displacement.y > 0.f ? -1.f : 1.f;
+    }
+    else if (start.y <= minY || start.y >= maxY)
+    {
+        return false;
+    }
+
+    float enter = std::max(enterX, enterY);
+    float exit = std::min(exitX, exitY);
+    if (enter > exit || enter < 0.f || enter > 1.f)
+    {
+        return false;
+    }
+
+    hit.time = enter;
+    hit.normal = enterX > enterY ? sf::Vector2f(normalX, 0.f) : sf::Vector2f(0.f, normalY);
+    return true;
+}
+
+// Entry time of a moving point into a disc it starts outside of
+inline bool rayEntersDisc(const sf::Vector2f& start, const sf::Vector2f& displacement,
+                          const sf::Vector2f& center, float radius, SweepHit& hit)
+{
+    sf::Vector2f offset = start - center;
+    float a = displacement.x * displacement.x + displacement.y * displacement.y;
+    float b = offset.x * displacement.x + offset.y * displacement.y;
+    float c = offset.x * offset.x + offset.y * offset.y - radius * radius;
+    if (a == 0.f || b >= 0.f)
+    {
+        return false; // Not moving, or moving away
+    }
+
+    float discriminant = b * b - a * c;
+    if (discriminant < 0.f)
+    {
+        return false;
+    }
+
+    float t = (-b - std::sqrt(discriminant)) / a;
+    if (t < 0.f || t > 1.f)
+    {
+        return false;
+    }
+
+    hit.time = t;
+    hit.normal = (offset + displacement * t) / radius;
+    return true;
+}
+
+} // namespace detail
+
+// Continuous circle vs box test. The circle's center moves by displacement
+// during the step; returns the earliest contact in [0, 1] if any.
+// The swept shape is the box grown by the radius with rounded corners, built
+// as the union of two grown boxes and four corner discs.
+template <typename Shape>
+inline bool sweepCircleBox(const Shape& shape, const sf::Vector2f& center, const sf::Vector2f& displacement,
+                           float left, float top, SweepHit& hit)
+{
+    float radius = shape.radius();
+    float right = left + shape.width();
+    float bottom = top + shape.height();
+
+    // Already touching: report an immediate hit along the axis of least penetration
+    sf::Vector2f position(center.x - radius, center.y - radius);
+    if (circleIntersectsBox(shape, position, left, top))
+    {
+        float dx = center.x - (left + right) / 2.f;
+        float dy = center.y - (top + bottom) / 2.f;
+        float overlapX = radius + shape.width() / 2.f - std::abs(dx);
+        float overlapY = radius + shape.height() / 2.f - std::abs(dy);
+        hit.time = 0.f;
+        hit.normal = overlapX < overlapY ? sf::Vector2f(dx > 0.f ? 1.f : -1.f, 0.f)
+                                         : sf::Vector2f(0.f, dy > 0.f ? 1.f : -1.f);
+        hit.startedInside = true;
+        return displacement.x * hit.normal.x + displacement.y * hit.normal.y < 0.f;
+    }
+
+    SweepHit best;
+    bool found = false;
+    SweepHit candidate;
+    auto keep = [&](bool entered)
+    {
+        if (entered && (!found || candidate.time < best.time))
+        {
+            best = candidate;
+            found = true;
+        }
+    };
+
+    keep(detail::rayEntersBox(center, displacement, left - radius, top, right + radius, bottom, candidate));
+    keep(detail::rayEntersBox(center, displacement, left, top - radius, right, bottom + radius, candidate));
+    keep(detail::rayEntersDisc(center, displacement, sf::Vector2f(left, top), radius, candidate));
+    keep(detail::rayEntersDisc(center, displacement, sf::Vector2f(right, top), radius, candidate));
+    keep(detail::rayEntersDisc(center, displacement, sf::Vector2f(left, bottom), radius, candidate));
+    keep(detail::rayEntersDisc(center, displacement, sf::Vector2f(right, bottom), radius, candidate));
+
+    if (found)
+    {
+        hit = best;
+        hit.startedInside = false;
+    }
+    return found;
+}
+
+inline bool sweepCircleAABB(const sf::Vector2f& center, const sf::Vector2f& displacement,
+                            float radius, const sf::FloatRect& aabb, SweepHit& hit)
+{
+    return sweepCircleBox(BoxShape{aabb.width, aabb.height, radius}, center, displacement, aabb.left, aabb.top, hit);
+}
+
+// Reflect a velocity off a surface with the given unit normal
+inline sf::Vector2f reflect(const sf::Vector2f& velocity, const sf::Vector2f& normal)
+{
+    float along = velocity.x * normal.x + velocity.y * normal.y;
+    return velocity - normal * (2.f * along);
+}
+
+} // namespace collision
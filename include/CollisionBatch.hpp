@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Collision.hpp"
+#include <cstddef>
+#include <cstdint>
+
+// Swept circle vs box narrow phase over several boxes at once (one ball against
+// the candidate bricks of a grid query). Every path gives bit-identical results
+// to sweepCircleBox run box by box, so replays do not depend on the CPU.
+namespace collision
+{
+
+constexpr std::size_t SWEEP_BATCH{8}; // Boxes per call: one AVX2 register, two SSE ones
+
+// Up to SWEEP_BATCH boxes, by top-left corner and size, in SoA form
+struct BoxBatch
+{
+    alignas(32) float left[SWEEP_BATCH];
+    alignas(32) float top[SWEEP_BATCH];
+    alignas(32) float width[SWEEP_BATCH];
+    alignas(32) float height[SWEEP_BATCH];
+    std::size_t count{0};
+
+    void push(float boxLeft, float boxTop, float boxWidth, float boxHeight)
+    {
+        left[count] = boxLeft;
+        top[count] = boxTop;
+        width[count] = boxWidth;
+        height[count] = boxHeight;
+        ++count;
+    }
+    bool full() const { return count == SWEEP_BATCH; }
+    void clear() { count = 0; }
+};
+
+struct SweepBatchHit
+{
+    std::uint32_t hitMask{0}; // Bit i set when the circle touches box i during the step
+    std::size_t earliest{0};  // Box of the earliest contact, the first one on ties
+    SweepHit hit;             // That contact
+};
+
+enum class SweepBatchPath
+{
+    Scalar, // sweepCircleBox box by box (reference)
+    Sse2,   // Two groups of four boxes
+    Avx2,   // All eight boxes at once
+};
+
+// Whether this build and CPU can run the path (Scalar always can)
+bool isSweepBatchPathSupported(SweepBatchPath path);
+// Widest supported path, picked once at startup
+SweepBatchPath getSweepBatchPath();
+const char* getSweepBatchPathName(SweepBatchPath path);
+
+// Sweep the circle against every box of the batch; returns whether any was hit
+bool sweepCircleBoxes(const sf::Vector2f& center, const sf::Vector2f& displacement, float radius,
+                      const BoxBatch& boxes, SweepBatchHit& result);
+// Same on a given path, which must be supported (tests and benchmarks)
+bool sweepCircleBoxes(SweepBatchPath path, const sf::Vector2f& center, const sf::Vector2f& displacement,
+                      float radius, const BoxBatch& boxes, SweepBatchHit& result);
+
+} // namespace collision
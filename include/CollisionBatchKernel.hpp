@@ -0,0 +1,223 @@
+#pragma once
+
+// Internal to CollisionBatch*.cpp: the SIMD sweep written once over a small
+// set of vector operations, instantiated for SSE2 and AVX2 in their own
+// translation units (the AVX2 one enables AVX2 on its own functions only).
+//
+// It mirrors sweepCircleBox operation for operation, so it must change with
+// it: same operand order in min / max (std::min(a, b) is b < a ? b : a), same
+// association of sums, no fused multiply-add.
+
+#include "CollisionBatch.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+// Set by CMake on x86-64 with GCC or Clang
+#ifndef CASSEBRIQUES_X86_SIMD
+#define CASSEBRIQUES_X86_SIMD 0
+#endif
+
+// Target attribute of sweepLanes and its lambdas, defined before including this
+// header by the translation unit that instantiates it for a wider set. Inline
+// code from other headers (std::min, ...) keeps the default target, so the
+// linker can never pick an AVX2-encoded copy of it for the whole program.
+#ifndef CASSEBRIQUES_SWEEP_TARGET
+#define CASSEBRIQUES_SWEEP_TARGET
+#endif
+
+namespace collision
+{
+namespace detail
+{
+
+// Per-box results of one batch. Disc (corner) contacts leave their normal
+// undivided by the radius: only the earliest contact's is ever needed.
+struct SweepLanes
+{
+    alignas(32) float time[SWEEP_BATCH];
+    alignas(32) float normalX[SWEEP_BATCH];
+    alignas(32) float normalY[SWEEP_BATCH];
+    std::uint32_t found{0};
+    std::uint32_t inside{0};
+    std::uint32_t corner{0};
+};
+
+// Boxes further than this from the swept circle's bounds cannot be hit, rounding
+// included; a group of such boxes skips the sweep
+constexpr float SWEEP_MARGIN{1.f};
+
+// Ops provides: V, WIDTH, set1, load, store, add, sub, mul, div, sqrt, abs,
+// negate, stdMin, stdMax, lt, le, gt, ge, andMask, orMask, notMask,
+// select(mask, a, b), movemask
+template <typename Ops>
+CASSEBRIQUES_SWEEP_TARGET void sweepLanes(const sf::Vector2f& center, const sf::Vector2f& displacement, float radius, const BoxBatch& boxes,
+                SweepLanes& lanes)
+{
+    using V = typename Ops::V;
+
+    // Values shared by every box, computed exactly as the scalar code does
+    const float positionX = center.x - radius;
+    const float positionY = center.y - radius;
+    const V r = Ops::set1(radius);
+    const V radiusSquared = Ops::set1(radius * radius);
+    const V centerX = Ops::set1(center.x);
+    const V centerY = Ops::set1(center.y);
+    const V overlapCenterX = Ops::set1(positionX + radius); // circleIntersectsBox's centre
+    const V overlapCenterY = Ops::set1(positionY + radius);
+    const V moveX = Ops::set1(displacement.x);
+    const V moveY = Ops::set1(displacement.y);
+    const V zero = Ops::set1(0.f);
+    const V one = Ops::set1(1.f);
+    const V minusOne = Ops::set1(-1.f);
+    const V allTrue = Ops::ge(one, zero);
+    const V allFalse = Ops::lt(one, zero);
+    const V half = Ops::set1(0.5f); // x * 0.5f is exactly x / 2.f
+    const V infinity = Ops::set1(std::numeric_limits<float>::infinity());
+    const V minusInfinity = Ops::set1(-std::numeric_limits<float>::infinity());
+
+    const bool movesX = displacement.x != 0.f;
+    const bool movesY = displacement.y != 0.f;
+    const V inverseX = Ops::set1(movesX ? 1.f / displacement.x : 0.f);
+    const V inverseY = Ops::set1(movesY ? 1.f / displacement.y : 0.f);
+    const V boxNormalX = Ops::set1(movesX ? (displacement.x > 0.f ? -1.f : 1.f) : 0.f);
+    const V boxNormalY = Ops::set1(movesY ? (displacement.y > 0.f ? -1.f : 1.f) : 0.f);
+    const float lengthSquared = displacement.x * displacement.x + displacement.y * displacement.y;
+    const V a = Ops::set1(lengthSquared);
+
+    const V sweepLeft = Ops::set1(std::min(center.x, center.x + displacement.x) - radius - SWEEP_MARGIN);
+    const V sweepTop = Ops::set1(std::min(center.y, center.y + displacement.y) - radius - SWEEP_MARGIN);
+    const V sweepRight = Ops::set1(std::max(center.x, center.x + displacement.x) + radius + SWEEP_MARGIN);
+    const V sweepBottom = Ops::set1(std::max(center.y, center.y + displacement.y) + radius + SWEEP_MARGIN);
+
+    for (std::size_t first = 0; first < SWEEP_BATCH; first += Ops::WIDTH)
+    {
+        const V left = Ops::load(boxes.left + first);
+        const V top = Ops::load(boxes.top + first);
+        const V width = Ops::load(boxes.width + first);
+        const V height = Ops::load(boxes.height + first);
+        const V right = Ops::add(left, width);
+        const V bottom = Ops::add(top, height);
+
+        V near = Ops::andMask(Ops::andMask(Ops::le(left, sweepRight), Ops::ge(right, sweepLeft)),
+                              Ops::andMask(Ops::le(top, sweepBottom), Ops::ge(bottom, sweepTop)));
+        if (Ops::movemask(near) == 0)
+        {
+            continue;
+        }
+
+        // Already touching: immediate hit along the axis of least penetration
+        V closestX = Ops::stdMax(left, Ops::stdMin(overlapCenterX, right));
+        V closestY = Ops::stdMax(top, Ops::stdMin(overlapCenterY, bottom));
+        V offsetX = Ops::sub(overlapCenterX, closestX);
+        V offsetY = Ops::sub(overlapCenterY, closestY);
+        V distanceSquared = Ops::add(Ops::mul(offsetX, offsetX), Ops::mul(offsetY, offsetY));
+        V inside = Ops::lt(distanceSquared, radiusSquared);
+
+        V dx = Ops::sub(centerX, Ops::mul(Ops::add(left, right), half));
+        V dy = Ops::sub(centerY, Ops::mul(Ops::add(top, bottom), half));
+        V overlapX = Ops::sub(Ops::add(r, Ops::mul(width, half)), Ops::abs(dx));
+        V overlapY = Ops::sub(Ops::add(r, Ops::mul(height, half)), Ops::abs(dy));
+        V alongX = Ops::lt(overlapX, overlapY);
+        V insideNormalX = Ops::select(alongX, Ops::select(Ops::gt(dx, zero), one, minusOne), zero);
+        V insideNormalY = Ops::select(alongX, zero, Ops::select(Ops::gt(dy, zero), one, minusOne));
+        V approach = Ops::add(Ops::mul(moveX, insideNormalX), Ops::mul(moveY, insideNormalY));
+        V insideFound = Ops::lt(approach, zero);
+
+        // Otherwise the earliest entry into the rounded, grown box
+        V bestTime = one;
+        V bestNormalX = zero;
+        V bestNormalY = zero;
+        V found = allFalse;
+        V corner = allFalse;
+        auto keep = [&](V entered, V time, V normalX, V normalY, V isCorner) CASSEBRIQUES_SWEEP_TARGET
+        {
+            V take = Ops::andMask(entered, Ops::orMask(Ops::notMask(found), Ops::lt(time, bestTime)));
+            bestTime = Ops::select(take, time, bestTime);
+            bestNormalX = Ops::select(take, normalX, bestNormalX);
+            bestNormalY = Ops::select(take, normalY, bestNormalY);
+            corner = Ops::select(take, isCorner, corner);
+            found = Ops::orMask(found, entered);
+        };
+
+        // detail::rayEntersBox
+        auto enterBox = [&](V minX, V minY, V maxX, V maxY) CASSEBRIQUES_SWEEP_TARGET
+        {
+            V valid = allTrue;
+            V enterX = minusInfinity;
+            V exitX = infinity;
+            V enterY = minusInfinity;
+            V exitY = infinity;
+            if (movesX)
+            {
+                V t1 = Ops::mul(Ops::sub(minX, centerX), inverseX);
+                V t2 = Ops::mul(Ops::sub(maxX, centerX), inverseX);
+                enterX = Ops::stdMin(t1, t2);
+                exitX = Ops::stdMax(t1, t2);
+            }
+            else
+            {
+                valid = Ops::notMask(Ops::orMask(Ops::le(centerX, minX), Ops::ge(centerX, maxX)));
+            }
+            if (movesY)
+            {
+                V t1 = Ops::mul(Ops::sub(minY, centerY), inverseY);
+                V t2 = Ops::mul(Ops::sub(maxY, centerY), inverseY);
+                enterY = Ops::stdMin(t1, t2);
+                exitY = Ops::stdMax(t1, t2);
+            }
+            else
+            {
+                valid = Ops::andMask(valid,
+                                     Ops::notMask(Ops::orMask(Ops::le(centerY, minY), Ops::ge(centerY, maxY))));
+            }
+
+            V enter = Ops::stdMax(enterX, enterY);
+            V exit = Ops::stdMin(exitX, exitY);
+            V rejected = Ops::orMask(Ops::gt(enter, exit), Ops::orMask(Ops::lt(enter, zero), Ops::gt(enter, one)));
+            V alongEnterX = Ops::gt(enterX, enterY);
+            keep(Ops::andMask(valid, Ops::notMask(rejected)), enter, Ops::select(alongEnterX, boxNormalX, zero),
+                 Ops::select(alongEnterX, zero, boxNormalY), allFalse);
+        };
+
+        // detail::rayEntersDisc
+        auto enterDisc = [&](V cornerX, V cornerY) CASSEBRIQUES_SWEEP_TARGET
+        {
+            if (lengthSquared == 0.f)
+            {
+                return;
+            }
+            V fromX = Ops::sub(centerX, cornerX);
+            V fromY = Ops::sub(centerY, cornerY);
+            V b = Ops::add(Ops::mul(fromX, moveX), Ops::mul(fromY, moveY));
+            V c = Ops::sub(Ops::add(Ops::mul(fromX, fromX), Ops::mul(fromY, fromY)), radiusSquared);
+            V discriminant = Ops::sub(Ops::mul(b, b), Ops::mul(a, c));
+            V t = Ops::div(Ops::sub(Ops::negate(b), Ops::sqrt(discriminant)), a);
+            V rejected = Ops::orMask(Ops::ge(b, zero), Ops::lt(discriminant, zero));
+            rejected = Ops::orMask(rejected, Ops::orMask(Ops::lt(t, zero), Ops::gt(t, one)));
+            // Divided by the radius once the earliest contact is known
+            V normalX = Ops::add(fromX, Ops::mul(moveX, t));
+            V normalY = Ops::add(fromY, Ops::mul(moveY, t));
+            keep(Ops::notMask(rejected), t, normalX, normalY, allTrue);
+        };
+
+        enterBox(Ops::sub(left, r), top, Ops::add(right, r), bottom);
+        enterBox(left, Ops::sub(top, r), right, Ops::add(bottom, r));
+        enterDisc(left, top);
+        enterDisc(right, top);
+        enterDisc(left, bottom);
+        enterDisc(right, bottom);
+
+        V time = Ops::select(inside, zero, bestTime);
+        Ops::store(lanes.time + first, time);
+        Ops::store(lanes.normalX + first, Ops::select(inside, insideNormalX, bestNormalX));
+        Ops::store(lanes.normalY + first, Ops::select(inside, insideNormalY, bestNormalY));
+        V hit = Ops::andMask(near, Ops::select(inside, insideFound, found));
+        lanes.found |= static_cast<std::uint32_t>(Ops::movemask(hit)) << first;
+        lanes.inside |= static_cast<std::uint32_t>(Ops::movemask(inside)) << first;
+        lanes.corner |= static_cast<std::uint32_t>(Ops::movemask(Ops::select(inside, allFalse, corner))) << first;
+    }
+}
+
+} // namespace detail
+} // namespace collision
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+// Typed publish / subscribe over a fixed set of event types.
+// Every type has its own dense subscriber array and its own queue: publish()
+// only appends, and dispatch() (once per tick) delivers the queued events type
+// by type, in the order of the template arguments, and in publish order within
+// a type. Subscribers are a plain function pointer and a context pointer, so a
+// delivery is one indirect call: no virtual dispatch, no std::function, and no
+// allocation once the bus is built.
+template <typename... Events>
+class EventBus
+{
+public:
+    template <typename Event>
+    using Handler = void (*)(void* context, const Event& event);
+
+    static constexpr std::size_t DEFAULT_QUEUE_CAPACITY{256};
+
+    // Each queue holds this many events; an event published into a full queue
+    // is delivered on the spot instead, so none is ever dropped
+    explicit EventBus(std::size_t queueCapacity = DEFAULT_QUEUE_CAPACITY)
+        : m_queueCapacity(queueCapacity)
+    {
+        (channel<Events>().queue.reserve(queueCapacity), ...);
+    }
+
+    // Subscribers are called in subscription order
+    template <typename Event>
+    void subscribe(Handler<Event> handler, void* context)
+    {
+        channel<Event>().subscribers.push_back(Subscriber<Event>{handler, context});
+    }
+
+    // Member function subscriber: bus.subscribe<Event, &Owner::onEvent>(owner)
+    template <typename Event, auto Method, typename Owner>
+    void subscribe(Owner& owner)
+    {
+        subscribe<Event>([](void* context, const Event& event) { (static_cast<Owner*>(context)->*Method)(event); },
+                         &owner);
+    }
+
+    // Remove every subscription made with this context, for all event types
+    void unsubscribe(const void* context) { (unsubscribe<Events>(context), ...); }
+
+    template <typename Event>
+    void publish(const Event& event)
+    {
+        Channel<Event>& target = channel<Event>();
+        if (target.queue.size() == m_queueCapacity)
+        {
+            deliver(target, event);
+            return;
+        }
+        target.queue.push_back(event);
+    }
+
+    // Deliver and drop everything queued. Events published by a subscriber go
+    // out in the same dispatch if their type is the same or comes later,
+    // otherwise in the next one.
+    void dispatch() { (dispatch<Events>(), ...); }
+
+    // Drop queued events without delivering them (new game, rollback)
+    void clear() { (channel<Events>().queue.clear(), ...); }
+
+    template <typename Event>
+    std::size_t getQueuedCount() const
+    {
+        return std::get<Channel<Event>>(m_channels).queue.size();
+    }
+
+private:
+    template <typename Event>
+    struct Subscriber
+    {
+        Handler<Event> handler;
+        void* context;
+    };
+
+    template <typename Event>
+    struct Channel
+    {
+        std::vector<Subscriber<Event>> subscribers;
+        std::vector<Event> queue;
+    };
+
+    std::tuple<Channel<Events>...> m_channels;
+    std::size_t m_queueCapacity;
+
+    template <typename Event>
+    Channel<Event>& channel()
+    {
+        static_assert((std::is_same_v<Event, Events> || ...), "event type is not carried by this bus");
+        return std::get<Channel<Event>>(m_channels);
+    }
+
+    template <typename Event>
+    static void deliver(const Channel<Event>& source, const Event& event)
+    {
+        for (std::size_t i = 0; i < source.subscribers.size(); ++i)
+        {
+            source.subscribers[i].handler(source.subscribers[i].context, event);
+        }
+    }
+
+    template <typename Event>
+    void dispatch()
+    {
+        Channel<Event>& source = channel<Event>();
+        // By index and by copy: subscribers may publish more of the same type
+        for (std::size_t i = 0; i < source.queue.size(); ++i)
+        {
+            Event event = source.queue[i];
+            deliver(source, event);
+        }
+        source.queue.clear();
+    }
+
+    template <typename Event>
+    void unsubscribe(const void* context)
+    {
+        std::vector<Subscriber<Event>>& subscribers = channel<Event>().subscribers;
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < subscribers.size(); ++i)
+        {
+            if (subscribers[i].context != context)
+            {
+                subscribers[kept++] = subscribers[i];
+            }
+        }
+        subscribers.resize(kept);
+    }
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+// Accumulator that turns variable frame times into a whole number of fixed
+// simulation steps, plus the interpolation factor for rendering in between.
+class FixedTimestep
+{
+public:
+    FixedTimestep(double stepSeconds, int maxStepsPerFrame);
+
+    // Add the frame time and return how many steps to run (at most maxStepsPerFrame).
+    // Time that would need more steps than that is dropped instead of piling up.
+    int advance(double frameSeconds);
+
+    // Fraction of a step left in the accumulator, in [0, 1)
+    float getAlpha() const { return static_cast<float>(m_accumulator / m_step); }
+    float getStepSeconds() const { return static_cast<float>(m_step); }
+    int getDroppedFrames() const { return m_droppedFrames; }
+
+private:
+    double m_step;
+    int m_maxSteps;
+    double m_accumulator{0.0};
+    int m_droppedFrames{0};
+};
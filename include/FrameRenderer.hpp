@@ -0,0 +1,28 @@
+#pragma once
+
+#include "BatchRenderer.hpp"
+#include "Hud.hpp"
+#include "RenderSnapshot.hpp"
+#include <SFML/Graphics.hpp>
+
+// A whole frame as the game shows it: the playfield, then the HUD over it.
+// The window and the offscreen golden-image checks both draw through this, so
+// what the checks compare is what players see.
+class FrameRenderer
+{
+public:
+    // Texts are invisible until a font is set, as in Hud
+    void setFont(const sf::Font& font) { m_hud.setFont(font); }
+    // Flat colours until an atlas is set, as in BatchRenderer
+    void setAtlas(const sf::Texture& texture, const TextureAtlas& atlas) { m_playfield.setAtlas(texture, atlas); }
+
+    // Clear the target and draw the snapshot, moving objects at alpha between steps
+    void draw(sf::RenderTarget& target, const RenderSnapshot& snapshot, float alpha);
+
+    const BatchRenderer& getPlayfield() const { return m_playfield; }
+    const Hud& getHud() const { return m_hud; }
+
+private:
+    BatchRenderer m_playfield;
+    Hud m_hud;
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Simulation.hpp"
+#include <SFML/Graphics.hpp>
+
+// Text layer over the playfield: menu title, lives/score, end-of-game screens.
+// The sf::Text objects live as long as the Hud; a string is only rebuilt (and its
+// glyphs laid out again) when the value it shows changes. Strings are built in
+// place in buffers sized up front, so neither steady frames nor score changes
+// allocate once every digit has been drawn once.
+class Hud : public sf::Drawable
+{
+public:
+    Hud();
+
+    // Texts are invisible until a font is set (it may still be loading)
+    void setFont(const sf::Font& font);
+
+    // Pick up lives, score and state; cheap when nothing changed
+    void update(Simulation::GameState state, int lives, int score);
+
+    // Number of text objects rebuilt by the last update (for headless checks)
+    int getLastRebuiltTextCount() const { return m_lastRebuilt; }
+
+protected:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+private:
+    sf::Text m_title;
+    sf::Text m_startPrompt;
+    sf::Text m_lives;
+    sf::Text m_score;
+    sf::RectangleShape m_overlay;
+    sf::Text m_gameOver;
+    sf::Text m_victory;
+    sf::Text m_finalScore;
+    sf::Text m_restartPrompt;
+
+    Simulation::GameState m_state;
+
+    // Last values laid out; -1 forces the first update to write them
+    int m_shownLives{-1};
+    int m_shownScore{-1};
+    int m_shownFinalScore{-1};
+    int m_lastRebuilt{0};
+
+    // Number texts are formatted into this string, which keeps its capacity
+    sf::String m_scratch;
+
+    void setNumber(sf::Text& text, const char* label, int value);
+};
@@ -1,28 +1,35 @@
 #pragma once
 
+#include "EventBus.hpp"
 #include <SFML/Window.hpp>
-#include <functional>
-#include <unordered_map>
-#include <vector>
+
+struct KeyPressedEvent
+{
+    sf::Keyboard::Key key{sf::Keyboard::Unknown};
+};
+
+struct MouseButtonPressedEvent
+{
+    sf::Mouse::Button button{sf::Mouse::Left};
+    int x{0};
+    int y{0};
+};
+
+using InputEvents = EventBus<KeyPressedEvent, MouseButtonPressedEvent>;
 
 class InputManager
 {
 public:
-    using KeyCallback = std::function<void()>;
-    using MouseCallback = std::function<void(int x, int y)>;
-
     static InputManager& getInstance();
 
-    // Process events (call this in your game loop)
+    // Queue the input of a window event (call this for every polled event)
     void processEvent(const sf::Event& event);
+    // Deliver what was queued since the last call (once per frame, after polling)
+    void dispatch() { m_events.dispatch(); }
 
-    // Keyboard bindings
-    void bindKey(sf::Keyboard::Key key, KeyCallback callback);
-    void unbindKey(sf::Keyboard::Key key);
-
-    // Mouse bindings
-    void bindMouseButton(sf::Mouse::Button button, MouseCallback callback);
-    void unbindMouseButton(sf::Mouse::Button button);
+    // Subscribers get every key or button and pick theirs, e.g.
+    // getEvents().subscribe<KeyPressedEvent, &Menu::onKeyPressed>(menu)
+    InputEvents& getEvents() { return m_events; }
 
     // Check if key is currently pressed
     bool isKeyPressed(sf::Keyboard::Key key) const;
@@ -36,8 +43,6 @@ private:
     InputManager(const InputManager&) = delete;
     InputManager& operator=(const InputManager&) = delete;
 
-    std::unordered_map<sf::Keyboard::Key, std::vector<KeyCallback>> m_keyBindings;
-    std::unordered_map<sf::Mouse::Button, std::vector<MouseCallback>> m_mouseBindings;
+    InputEvents m_events;
     sf::Vector2i m_mousePosition;
 };
-
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Simulation.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Fixed-capacity single-producer / single-consumer ring buffer. push() is only
+// called from one thread and pop() from one other; neither ever locks or allocates.
+template <typename T, std::size_t Capacity>
+class SpscRing
+{
+    static_assert((Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+public:
+    // Producer: false if the ring is full (the item is not queued)
+    bool push(const T& item)
+    {
+        std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == Capacity)
+        {
+            return false;
+        }
+        m_items[tail & (Capacity - 1)] = item;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: oldest item without removing it, nullptr if empty
+    const T* peek() const
+    {
+        std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        return &m_items[head & (Capacity - 1)];
+    }
+
+    // Consumer: drop the item returned by peek()
+    void pop() { m_head.store(m_head.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+private:
+    std::array<T, Capacity> m_items{};
+    // Each index on its own cache line so the two threads do not false-share
+    alignas(64) std::atomic<std::size_t> m_head{0};
+    alignas(64) std::atomic<std::size_t> m_tail{0};
+};
+
+// One input as it happened, stamped with InputQueue::now()
+struct InputEvent
+{
+    enum Type : std::uint8_t
+    {
+        PaddleMove, // x: desired paddle centre
+        Launch,
+        MultiBall, // count: extra balls per ball
+    };
+
+    Type type{PaddleMove};
+    std::int64_t timeMicroseconds{0};
+    float x{0.f};
+    int count{0};
+};
+
+// Input events travel from event polling to the simulation through this queue.
+// The simulation drains it at each tick boundary, taking exactly the events
+// that happened before that tick, and folds them into one SimulationInput;
+// that per-tick input is also what replays record.
+class InputQueue
+{
+public:
+    static constexpr std::size_t CAPACITY{1024};
+
+    // Timestamp for events and tick boundaries (steady clock, microseconds)
+    static std::int64_t now();
+
+    // Producer side; an event that does not fit is dropped and counted
+    void push(const InputEvent& event);
+
+    // Consumer side: input for a tick ending at `timeMicroseconds`. The paddle
+    // target persists between ticks; launch and multi-ball fire once.
+    SimulationInput drain(std::int64_t timeMicroseconds);
+
+    float getPaddleTargetX() const { return m_paddleTargetX; }
+    void setPaddleTargetX(float x) { m_paddleTargetX = x; }
+    std::size_t getDroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    SpscRing<InputEvent, CAPACITY> m_events;
+    std::atomic<std::size_t> m_dropped{0};
+    float m_paddleTargetX{Simulation::WINDOW_WIDTH / 2.f}; // Consumer only
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "BrickField.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+// Binary level pack, read in place from a memory-mapped file.
+//
+// Layout (little-endian):
+//   header: "CBLV", u16 version, u16 reserved, u32 level count, u32 reserved
+//   entries (one per level, 24 bytes): u32 cell offset, u16 cols, u16 rows,
+//            f32 brick width, f32 brick height, f32 spacing, f32 top
+//   cells:   one byte per cell, row-major: low nibble health (0 = no brick),
+//            high nibble brick type
+// Opening a pack only checks the header and entry table; cells are used
+// straight from the mapping, so pack size does not affect load time.
+enum class BrickType : std::uint8_t
+{
+    Standard = 0 // Types 1-15 are reserved and currently play as Standard
+};
+
+struct LevelView
+{
+    int cols{0};
+    int rows{0};
+    float brickWidth{0.f};
+    float brickHeight{0.f};
+    float spacing{0.f};
+    float top{0.f};
+    const std::uint8_t* cells{nullptr};
+
+    int getHealth(int col, int row) const { return cells[row * cols + col] & 0x0F; }
+    BrickType getType(int col, int row) const { return static_cast<BrickType>(cells[row * cols + col] >> 4); }
+
+    // Append the level's bricks, centred horizontally in a playfield of the given width
+    void appendBricks(BrickField& bricks, float playfieldWidth) const;
+};
+
+class LevelPack
+{
+public:
+    LevelPack() = default;
+    ~LevelPack();
+    LevelPack(const LevelPack&) = delete;
+    LevelPack& operator=(const LevelPack&) = delete;
+
+    // Map a compiled pack; returns false (and leaves the pack empty) if it is invalid
+    bool open(const std::string& path);
+    // Use a pack already in memory; the bytes must outlive the pack
+    bool openFromMemory(const std::uint8_t* data, std::size_t size);
+    void close();
+
+    std::size_t getLevelCount() const { return m_levelCount; }
+    LevelView getLevel(std::size_t index) const;
+
+private:
+    const std::uint8_t* m_data{nullptr};
+    std::size_t m_size{0};
+    std::size_t m_levelCount{0};
+
+    // Platform mapping (or fallback buffer) owned by the pack
+    void* m_mapping{nullptr};
+    std::size_t m_mappingSize{0};
+    std::vector<std::uint8_t> m_buffer;
+
+    bool validate();
+};
+
+// Compile the text authoring format into a binary pack.
+//
+//   # comment
+//   level
+//   brick 70 30      (optional: brick width and height, default 70 x 30)
+//   spacing 5        (optional, default 5)
+//   top 50           (optional: y of the first row, default 50)
+//   5555555555       one line per row: '1'-'9' a brick with that health,
+//   44.44..44        '.' or ' ' no brick; shorter rows are padded with gaps,
+//                    a blank line is a row of gaps
+//   end
+//
+// Returns false with a "line N: ..." message on the first error.
+bool compileLevelText(std::istream& input, std::vector<std::uint8_t>& pack, std::string& error);
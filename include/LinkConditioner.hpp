@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+// Bad network on demand: datagrams go in, and come out later, possibly out of
+// order, or never. Used by UdpLink before sending and by the benchmarks
+// between two in-process peers. Fixed capacity, never allocates; times are in
+// microseconds on any clock the caller likes (InputQueue::now() for real time).
+class LinkConditioner
+{
+public:
+    static constexpr std::size_t MAX_DATAGRAM_SIZE{256};
+    static constexpr std::size_t CAPACITY{256}; // Datagrams in flight
+
+    struct Conditions
+    {
+        double latencyMilliseconds{0.0}; // One way
+        double jitterMilliseconds{0.0};  // Added to the latency, uniform in [0, jitter]
+        double lossRate{0.0};            // 0..1, per datagram
+        std::uint32_t seed{1};
+    };
+
+    struct Stats
+    {
+        std::uint64_t pushed{0};
+        std::uint64_t lost{0};       // Dropped on purpose (lossRate)
+        std::uint64_t overflowed{0}; // Dropped: too large, or the queue was full
+        std::uint64_t delivered{0};
+    };
+
+    void setConditions(const Conditions& conditions);
+    const Conditions& getConditions() const { return m_conditions; }
+
+    // Queue a datagram sent at `nowMicroseconds`; false if it was dropped
+    bool push(const unsigned char* data, std::size_t size, std::int64_t nowMicroseconds);
+    // Next datagram due by `nowMicroseconds`, in due order; false if none.
+    // Datagrams larger than capacity are dropped.
+    bool pop(std::int64_t nowMicroseconds, unsigned char* out, std::size_t capacity, std::size_t& size);
+
+    std::size_t getInFlightCount() const { return m_count; }
+    const Stats& getStats() const { return m_stats; }
+
+private:
+    struct Datagram
+    {
+        std::int64_t dueMicroseconds{0};
+        std::uint64_t sequence{0}; // Same due time: sent order
+        std::size_t size{0};
+        std::array<unsigned char, MAX_DATAGRAM_SIZE> bytes{};
+    };
+
+    Conditions m_conditions;
+    std::mt19937 m_random{1};
+    std::array<Datagram, CAPACITY> m_datagrams{}; // Unordered, first m_count in use
+    std::size_t m_count{0};
+    std::uint64_t m_nextSequence{0};
+    Stats m_stats;
+};
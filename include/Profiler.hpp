@@ -0,0 +1,120 @@
+#pragma once
+
+// Scoped frame-time profiler. Everything here only exists when the build
+// defines CASSEBRIQUES_PROFILING (CMake option of the same name); otherwise
+// CB_PROFILE_SCOPE expands to nothing and no timing code is compiled.
+
+#ifdef CASSEBRIQUES_PROFILING
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Timed sections. Times are inclusive: BallPhysics contains BrickCollision,
+// Frame contains everything else.
+enum class ProfileSection
+{
+    Frame,
+    Events,
+    Simulation,
+    Paddle,
+    BallPhysics,
+    BrickCollision,
+    Cleanup, // Compacting dead bricks out of the grid
+    Render,
+    Count
+};
+
+class Profiler
+{
+public:
+    static constexpr std::size_t SECTION_COUNT{static_cast<std::size_t>(ProfileSection::Count)};
+    static constexpr std::size_t WINDOW_FRAMES{240};    // Rolling window for the overlay stats
+    static constexpr std::size_t HISTORY_FRAMES{18000}; // Kept for the CSV: five minutes at 60 fps
+
+    struct Stats
+    {
+        float minMicroseconds{0.f};
+        float avgMicroseconds{0.f};
+        float p99Microseconds{0.f};
+    };
+
+    static Profiler& getInstance();
+    static const char* getSectionName(ProfileSection section);
+
+    // Add time to the section for the current frame (from any thread)
+    void add(ProfileSection section, std::chrono::nanoseconds elapsed)
+    {
+        m_current[static_cast<std::size_t>(section)].fetch_add(elapsed.count(), std::memory_order_relaxed);
+    }
+
+    // Close the current frame: store its totals and start a new one.
+    // A frame in which nothing was timed is not recorded. Called by the render
+    // thread, which is also the only one reading the stats; simulation steps
+    // running meanwhile count towards the frame they end in.
+    void endFrame();
+
+    // Min / average / 99th percentile of the section over the last WINDOW_FRAMES frames
+    Stats getStats(ProfileSection section) const;
+    std::size_t getFrameCount() const { return m_frameCount; }
+
+    // One row per frame, one column per section, in microseconds; the last
+    // HISTORY_FRAMES frames only, numbered from the first frame recorded
+    bool writeCsv(const std::string& path) const;
+
+private:
+    using FrameSample = std::array<float, SECTION_COUNT>;
+
+    Profiler();
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    std::array<std::atomic<std::int64_t>, SECTION_COUNT> m_current{};
+    std::vector<FrameSample> m_history; // Ring of HISTORY_FRAMES samples, sized once
+    std::size_t m_frameCount{0};        // Frames recorded; the next one goes to m_frameCount % HISTORY_FRAMES
+
+    const FrameSample& getRecentFrame(std::size_t age) const
+    {
+        return m_history[(m_frameCount - 1 - age) % HISTORY_FRAMES];
+    }
+};
+
+// Adds the lifetime of the scope to a section
+class ProfileScope
+{
+public:
+    explicit ProfileScope(ProfileSection section)
+        : m_section(section)
+        , m_start(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~ProfileScope()
+    {
+        Profiler::getInstance().add(m_section, std::chrono::steady_clock::now() - m_start);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfileSection m_section;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+#define CB_PROFILE_CONCAT_INNER(a, b) a##b
+#define CB_PROFILE_CONCAT(a, b) CB_PROFILE_CONCAT_INNER(a, b)
+#define CB_PROFILE_SCOPE(section) \
+    ProfileScope CB_PROFILE_CONCAT(cbProfileScope, __LINE__)(ProfileSection::section)
+#define CB_PROFILE_END_FRAME() Profiler::getInstance().endFrame()
+
+#else
+
+#define CB_PROFILE_SCOPE(section) ((void)0)
+#define CB_PROFILE_END_FRAME() ((void)0)
+
+#endif
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "BallField.hpp"
+#include "BrickField.hpp"
+#include "Simulation.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Everything drawing needs from one simulation step, copied out so the
+// simulation can keep stepping on its own thread while the copy is drawn.
+struct RenderSnapshot
+{
+    RenderSnapshot() { balls.reserve(Simulation::MAX_BALLS); }
+
+    Simulation::GameState state{Simulation::MENU};
+    int lives{Simulation::INITIAL_LIVES};
+    int score{0};
+    std::uint64_t tick{0};
+    std::int64_t tickEndMicroseconds{0}; // Wall-clock time the step stands for (InputQueue::now())
+    std::uint64_t commandsRun{0};        // Commands posted to the SimulationThread applied before it
+
+    sf::Vector2f previousPaddlePosition;
+    sf::Vector2f paddlePosition;
+    sf::Vector2f paddleSize;
+    BallField balls{Simulation::BALL_RADIUS};
+    BrickField bricks;
+
+    // Copy the simulation's state. Bricks are synced incrementally, and all
+    // storage is reused, so capturing a running level does not allocate.
+    void capture(const Simulation& simulation, std::int64_t tickEndMicroseconds);
+};
+
+// Lock-free triple buffer handing snapshots from one producer to one consumer.
+// The producer always has a buffer to write, the consumer always has a complete
+// one to read, and the third holds the newest published snapshot between them.
+class SnapshotBuffer
+{
+public:
+    // Producer: the buffer to fill next (holds an older snapshot)
+    RenderSnapshot& beginWrite() { return m_buffers[m_write]; }
+    // Producer: make the buffer from beginWrite() the newest snapshot
+    void publish();
+
+    // Consumer: newest published snapshot; it stays unchanged until the next acquire()
+    const RenderSnapshot& acquire();
+
+private:
+    static constexpr std::uint8_t FRESH{4}; // Set on m_ready when the producer published since the last acquire
+
+    std::array<RenderSnapshot, 3> m_buffers;
+    std::atomic<std::uint8_t> m_ready{1}; // Buffer index, plus FRESH
+    std::uint8_t m_write{0};              // Producer only
+    std::uint8_t m_read{2};               // Consumer only
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Simulation.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Binary input log for one game, from Simulation::startGame() onwards.
+//
+// Layout (little-endian):
+//   header: "CBRP", u16 version, u16 steps per second, f32 ball speed multiplier, u32 tick count
+//   runs:   u16 repeat count, f32 paddle target X, u8 flags (bit 0 launch, bits 1-7 multi-ball extras)
+// Identical consecutive ticks share one 7-byte run, so idle stretches cost almost nothing.
+class ReplayRecorder
+{
+public:
+    ReplayRecorder();
+
+    void clear();
+    void setBallSpeedMultiplier(float multiplier) { m_ballSpeedMultiplier = multiplier; }
+    void record(const SimulationInput& input);
+
+    std::size_t getTickCount() const { return m_tickCount; }
+    std::vector<std::uint8_t> toBytes() const;
+    bool saveToFile(const std::string& path) const;
+
+private:
+    struct Run
+    {
+        std::uint16_t repeat;
+        float paddleTargetX;
+        std::uint8_t flags;
+    };
+
+    std::vector<Run> m_runs;
+    std::size_t m_tickCount;
+    float m_ballSpeedMultiplier;
+};
+
+// Feeds a recorded log back into a Simulation, one input per tick
+class ReplayPlayer
+{
+public:
+    bool loadFromFile(const std::string& path);
+    bool loadFromMemory(const std::uint8_t* data, std::size_t size);
+
+    // Start a fresh game configured like the recorded one
+    void begin(Simulation& simulation);
+
+    // Next recorded input; returns false once the log is exhausted
+    bool next(SimulationInput& input);
+
+    bool isFinished() const { return m_cursor >= m_data.size() && m_runRemaining == 0; }
+    std::size_t getTickCount() const { return m_tickCount; }
+    int getStepsPerSecond() const { return m_stepsPerSecond; }
+
+private:
+    std::vector<std::uint8_t> m_data;
+    std::size_t m_cursor{0};
+    std::uint16_t m_runRemaining{0};
+    SimulationInput m_runInput;
+    std::size_t m_tickCount{0};
+    int m_stepsPerSecond{0};
+    float m_ballSpeedMultiplier{1.f};
+};
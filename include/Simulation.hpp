@@ -0,0 +1,204 @@
+#pragma once
+
+#include "BallField.hpp"
+#include "BrickField.hpp"
+#include "Collision.hpp"
+#include "EventBus.hpp"
+#include "LevelPack.hpp"
+#include "Paddle.hpp"
+#include "SpatialGrid.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Player input sampled once per simulation step.
+// Filled by the renderer from window events, or by a bot / replay when headless.
+struct SimulationInput
+{
+    float paddleTargetX{0.f}; // Desired paddle centre on the X axis
+    bool launch{false};       // Launch the ball if it is resting on the paddle
+    int multiBall{0};         // Multi-ball power-up: extra balls per ball in play
+};
+
+// Gameplay events, published during a step and delivered at its end
+struct BrickDestroyedEvent
+{
+    std::uint32_t brick{0}; // Index in Simulation::getBricks()
+    int points{0};          // What it is worth to the score
+};
+
+struct ScoreChangedEvent
+{
+    int score{0}; // New total
+    int delta{0};
+};
+
+struct LifeLostEvent
+{
+    int livesLeft{0}; // 0 when this loss ends the game
+};
+
+using SimulationEvents = EventBus<BrickDestroyedEvent, ScoreChangedEvent, LifeLostEvent>;
+
+// Gameplay state at the end of a step, for rollback and rewinding. The scalar
+// state and the balls are packed into one flat buffer, sized for MAX_BALLS on
+// first use so later saves never allocate. Bricks are not copied: the snapshot
+// keeps a position in the brick change log, and restoring undoes the changes
+// logged since, so a save costs the same whatever the level size.
+class SimulationSnapshot
+{
+public:
+    bool isValid() const { return !m_bytes.empty(); }
+    std::uint64_t getTick() const { return m_tick; }
+    std::size_t getByteSize() const { return m_bytes.size(); }
+
+private:
+    friend class Simulation;
+    std::vector<unsigned char> m_bytes;
+    std::uint64_t m_tick{0};
+};
+
+// Gameplay state and rules, with no window, font or GPU dependency
+class Simulation
+{
+public:
+    enum GameState { MENU, PLAYING, GAME_OVER, VICTORY };
+
+    static constexpr unsigned int WINDOW_WIDTH{800u};
+    static constexpr unsigned int WINDOW_HEIGHT{600u};
+    static constexpr float BALL_RADIUS{8.f};
+    static constexpr float BALL_SPEED{400.f};
+    static constexpr float BALL_GRAVITY{50.f}; // Pixels per second squared, once launched
+    static constexpr float MULTIBALL_SPREAD_DEGREES{15.f};
+    static constexpr std::size_t MAX_BALLS{8192}; // Ball storage is allocated once, up front
+    static constexpr float PADDLE_WIDTH{100.f};
+    static constexpr float PADDLE_HEIGHT{15.f};
+    static constexpr float PADDLE_DEFLECTION_DEGREES{60.f}; // Rebound angle at the paddle's edges
+    static constexpr float BRICK_WIDTH{70.f};
+    static constexpr float BRICK_HEIGHT{30.f};
+    static constexpr float BRICK_SPACING{5.f};
+    static constexpr int BRICK_ROWS{5};
+    static constexpr int BRICK_COLS{10};
+    static constexpr int INITIAL_LIVES{3};
+    static constexpr int BRICK_POINTS{10};
+
+    // Physics always advances by this fixed step, whatever the display rate
+    static constexpr int STEPS_PER_SECOND{120};
+    static constexpr float STEP_SECONDS{1.f / STEPS_PER_SECOND};
+    static constexpr int MAX_STEPS_PER_FRAME{8};
+    static constexpr int MAX_BOUNCES_PER_STEP{8};
+
+    Simulation();
+    // Its own subscriptions point back at it
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+
+    // State transitions driven by menu keys
+    void startGame();
+    void returnToMenu();
+
+    // Start a game on a custom brick layout instead of the default wall
+    // (bricks start at their max health). A running level never allocates as
+    // long as no brick has more than 15 health, the level format's maximum:
+    // the brick change log is only reserved up to that many hits per brick.
+    void startGame(const BrickField& layout);
+    // Start a game on a level from a level pack
+    void startGame(const LevelView& level);
+
+    // Advance the game by one fixed step (no-op outside of PLAYING).
+    // The same input sequence from the same starting state always produces
+    // bit-identical state on a given build, which is what replays rely on.
+    void step(const SimulationInput& input);
+
+    // Multi-ball power-up: every ball in play spawns extraPerBall copies fanned
+    // out around its direction, up to MAX_BALLS. Large counts double as a stress test.
+    void spawnMultiBall(int extraPerBall);
+
+    // Scales the launch and paddle rebound speed (challenge modes)
+    void setBallSpeedMultiplier(float multiplier) { m_ballSpeedMultiplier = multiplier; }
+    // Largest rebound angle off the paddle, from vertical (level balancing)
+    void setPaddleDeflection(float degrees) { m_paddleDeflectionDegrees = degrees; }
+
+    GameState getState() const { return m_state; }
+    int getLives() const { return m_lives; }
+    int getScore() const { return m_score; }
+    bool isBallLaunched() const { return m_ballLaunched; }
+    std::uint64_t getTick() const { return m_tick; }
+    // Paddle rebounds this game (statistics only, not part of the state hash)
+    int getPaddleBounces() const { return m_paddleBounces; }
+
+    // Positions at the start of the last step, for interpolated rendering
+    sf::Vector2f getPreviousPaddlePosition() const { return m_previousPaddlePosition; }
+
+    // FNV-1a hash over the full gameplay state, for desync and regression checks
+    std::uint64_t computeStateHash() const;
+
+    // Save the state between two steps. Restoring it and stepping with the same
+    // inputs reproduces the same states bit for bit. A snapshot can only be
+    // restored within the game it was saved in (false otherwise, nothing changes).
+    // Restoring drops the brick changes made since, so snapshots saved after the
+    // restored one are stale: save them again before restoring one of them.
+    // No events are published either way.
+    void saveState(SimulationSnapshot& snapshot) const;
+    bool restoreState(const SimulationSnapshot& snapshot);
+
+    const Paddle& getPaddle() const { return *m_paddle; }
+    const BallField& getBalls() const { return m_balls; }
+    const BrickField& getBricks() const { return m_bricks; }
+
+    // Events of a step are delivered at the end of step(), on the thread that
+    // steps. Scoring is itself a subscriber (the first one) to brick destruction.
+    SimulationEvents& getEvents() { return m_events; }
+
+private:
+    enum class ContactTarget { None, Wall, Paddle, Brick };
+
+    struct Contact
+    {
+        ContactTarget target{ContactTarget::None};
+        collision::SweepHit hit;
+        std::uint32_t brick{0};
+    };
+
+    // Brick sizes of the level, which pick the brick collision kernel: the
+    // classic size is baked in at compile time, a uniform size is read once
+    // per sweep, and mixed sizes fall back to per-brick dimensions
+    enum class BrickSizes { Classic, Uniform, Mixed };
+
+    GameState m_state;
+    int m_lives;
+    int m_score;
+
+    std::unique_ptr<Paddle> m_paddle;
+    BallField m_balls;
+    BrickField m_bricks;
+    SpatialGrid m_brickGrid;
+    std::vector<sf::FloatRect> m_brickBoxes; // Scratch for grid rebuilds, kept between levels
+    std::size_t m_bricksInGrid; // Live bricks at the last grid build or compaction
+    std::uint64_t m_gridBuilds; // Builds and compactions so far: a restore may need the dropped bricks back
+    BrickSizes m_brickSizes;
+    sf::Vector2f m_brickSize; // Size of every brick unless Mixed
+    bool m_ballLaunched;
+    std::uint64_t m_tick;
+    sf::Vector2f m_previousPaddlePosition;
+    float m_ballSpeedMultiplier;
+    float m_paddleDeflectionDegrees;
+    int m_paddleBounces;
+    SimulationEvents m_events;
+
+    void resetGame();
+    void createBricks();
+    void rebuildBrickGrid();
+    void compactBrickGrid();
+    void resetBall();
+    void launchBall();
+    sf::Vector2f restingBallPosition() const;
+    void updatePaddle(float targetX, float deltaTime);
+    void storePreviousPositions();
+    void updateBalls(float deltaTime);
+    bool updateBall(std::size_t index, float deltaTime);
+    sf::Vector2f deflectOffPaddle(const sf::Vector2f& ballCenter, const sf::Vector2f& velocity) const;
+    void checkGameOver();
+    void checkVictory();
+    void scoreBrick(const BrickDestroyedEvent& event);
+};
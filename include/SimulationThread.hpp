@@ -0,0 +1,61 @@
+#pragma once
+
+#include "FixedTimestep.hpp"
+#include "RenderSnapshot.hpp"
+#include "Simulation.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Steps a Simulation at its fixed rate on a thread of its own and publishes a
+// RenderSnapshot after every step, so a slow display (vsync, frame limit) never
+// holds physics back. Only this thread touches the Simulation while it runs;
+// other threads read snapshots and post commands.
+class SimulationThread
+{
+public:
+    // Runs one step; receives the wall-clock end of the step (InputQueue::now()
+    // units) so it can take exactly the input that happened before it
+    using StepFunction = std::function<void(std::int64_t tickEndMicroseconds)>;
+
+    SimulationThread(Simulation& simulation, StepFunction step);
+    ~SimulationThread();
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    void start();
+    // Finish the current step and join; the Simulation is free to use afterwards
+    void stop();
+
+    // Run `command` on the simulation thread before its next step (state
+    // transitions from the menu, level starts). Commands run in posting order.
+    void post(std::function<void()> command);
+    // Whether the snapshot already reflects every command posted so far; the
+    // state it shows may be about to change otherwise (posting thread only)
+    bool isCurrent(const RenderSnapshot& snapshot) const { return snapshot.commandsRun == m_commandsPosted; }
+
+    // Newest snapshot; unchanged until the next call (render thread only)
+    const RenderSnapshot& acquireSnapshot() { return m_snapshots.acquire(); }
+
+private:
+    Simulation& m_simulation;
+    StepFunction m_step;
+    FixedTimestep m_timestep;
+    SnapshotBuffer m_snapshots;
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+
+    std::mutex m_commandMutex;
+    std::vector<std::function<void()>> m_commands;
+    std::vector<std::function<void()>> m_runningCommands; // Simulation thread only
+    std::atomic<bool> m_hasCommands{false}; // Lets steps skip the lock when nothing was posted
+    std::uint64_t m_commandsPosted{0};      // Posting thread only
+    std::uint64_t m_commandsRun{0};         // Simulation thread only
+
+    void run();
+    bool runCommands();
+    void publish(std::int64_t tickEndMicroseconds);
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Uniform grid broad-phase over static axis-aligned boxes.
+// With cells sized to the brick pitch every brick lands in a single cell, so a
+// query costs the number of cells it overlaps, whatever the number of bricks.
+class SpatialGrid
+{
+public:
+    explicit SpatialGrid(const sf::Vector2f& cellSize = sf::Vector2f(1.f, 1.f));
+
+    void setCellSize(const sf::Vector2f& cellSize) { m_cellSize = cellSize; }
+
+    // Index boxes[i] under id i (replaces any previous content)
+    void build(const std::vector<sf::FloatRect>& boxes);
+    void clear();
+
+    // Call visit(id) once for every box whose cells overlap the query area
+    template <typename Visitor>
+    void query(const sf::FloatRect& area, Visitor&& visit) const;
+
+    // Drop every id for which keep(id) is false; the others keep their order
+    // within each cell. Costs one pass over the stored ids.
+    template <typename Predicate>
+    void compact(Predicate&& keep);
+    // Stored ids: a box is counted once per cell it overlaps
+    std::size_t getEntryCount() const { return m_items.size(); }
+
+    int getCols() const { return m_cols; }
+    int getRows() const { return m_rows; }
+
+private:
+    struct CellRange
+    {
+        int x0, y0, x1, y1;
+    };
+
+    sf::Vector2f m_cellSize;
+    sf::Vector2f m_origin;
+    int m_cols{0};
+    int m_rows{0};
+
+    // Compressed cell lists: ids of cell c are m_items[m_cellStart[c] .. m_cellStart[c + 1])
+    std::vector<std::uint32_t> m_cellStart;
+    std::vector<std::uint32_t> m_items;
+    // First cell covered by each id, used to report multi-cell boxes only once
+    std::vector<std::uint32_t> m_itemMinCell;
+    std::vector<std::uint32_t> m_cursor; // Fill-pass scratch, kept so rebuilds reuse its memory
+
+    CellRange cellRange(const sf::FloatRect& area) const;
+};
+
+template <typename Visitor>
+void SpatialGrid::query(const sf::FloatRect& area, Visitor&& visit) const
+{
+    if (m_cols == 0 || m_rows == 0)
+    {
+        return;
+    }
+
+    CellRange range = cellRange(area);
+    for (int cy = range.y0; cy <= range.y1; ++cy)
+    {
+        for (int cx = range.x0; cx <= range.x1; ++cx)
+        {
+            std::size_t cell = static_cast<std::size_t>(cy) * m_cols + cx;
+            for (std::uint32_t i = m_cellStart[cell]; i < m_cellStart[cell + 1]; ++i)
+            {
+                std::uint32_t id = m_items[i];
+
+                // A box spanning several cells is only reported from the first
+                // of its cells that lies inside the query range
+                std::uint32_t minCell = m_itemMinCell[id];
+                int firstX = std::max(static_cast<int>(minCell % m_cols), range.x0);
+                int firstY = std::max(static_cast<int>(minCell / m_cols), range.y0);
+                if (cx == firstX && cy == firstY)
+                {
+                    visit(id);
+                }
+            }
+        }
+    }
+}
+
+template <typename Predicate>
+void SpatialGrid::compact(Predicate&& keep)
+{
+    if (m_cellStart.empty())
+    {
+        return;
+    }
+
+    // Cells are contiguous, so each one is read from where the previous one ended
+    std::size_t cellCount = m_cellStart.size() - 1;
+    std::uint32_t read = 0;
+    std::uint32_t write = 0;
+    for (std::size_t cell = 0; cell < cellCount; ++cell)
+    {
+        std::uint32_t end = m_cellStart[cell + 1];
+        m_cellStart[cell] = write;
+        for (; read < end; ++read)
+        {
+            if (keep(m_items[read]))
+            {
+                m_items[write++] = m_items[read];
+            }
+        }
+    }
+    m_cellStart[cellCount] = write;
+    m_items.resize(write);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool for independent CPU-bound tasks.
+// Each worker owns a deque: it runs its own tasks newest first and, once it
+// runs dry, steals the oldest task of another worker. Tasks of very different
+// lengths (a game lost in seconds next to one played for minutes) therefore
+// still keep every core busy, and workers only share a lock while stealing.
+class TaskPool
+{
+public:
+    // 0 threads means one per hardware thread
+    explicit TaskPool(unsigned int threadCount = 0);
+    ~TaskPool();
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    // Queue a task; tasks are spread over the workers round-robin
+    void submit(std::function<void()> task);
+    // Block until every submitted task has finished
+    void wait();
+
+    unsigned int getThreadCount() const { return static_cast<unsigned int>(m_workers.size()); }
+
+private:
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<std::size_t> m_nextWorker{0};
+    std::atomic<std::size_t> m_queued{0};    // Submitted, not yet picked up
+    std::atomic<std::size_t> m_unfinished{0}; // Submitted, not yet finished
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake; // Work queued or stopping
+    std::condition_variable m_idle; // m_unfinished dropped to 0
+    bool m_stopping{false};
+
+    void run(std::size_t self);
+    bool takeTask(std::size_t self, std::function<void()>& task);
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Brick.hpp"
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <vector>
+
+// Every sprite of the playfield, packed into one image so bricks, paddle and
+// balls still render with a single texture bind.
+enum class AtlasSprite
+{
+    White, // Plain texels for untextured quads (outlines)
+    Ball,
+    Paddle,
+    BrickLow, // One tinted brick per Brick::HealthState, in the same order
+    BrickMedium,
+    BrickHigh,
+    Count
+};
+
+// Shelf packing of rectangles into the smallest-area strip found.
+// Rects are separated by `padding` texels so filtering never bleeds between them.
+struct AtlasPacking
+{
+    sf::Vector2u size;
+    std::vector<sf::IntRect> rects; // Same order as the requested sizes
+
+    // Share of the atlas area covered by rects
+    float getDensity() const;
+};
+
+AtlasPacking packAtlas(const std::vector<sf::Vector2u>& sizes, unsigned int padding);
+
+// CPU side of the atlas: decoding, scaling and packing need no GL context, so
+// this can be built on the loader thread and uploaded to an sf::Texture later.
+class TextureAtlas
+{
+public:
+    static constexpr unsigned int PADDING{2};
+    static constexpr std::size_t SPRITE_COUNT{static_cast<std::size_t>(AtlasSprite::Count)};
+
+    // Scale the source images down to sprite size, tint the brick once per
+    // health state and pack everything. Returns false if an image is empty.
+    bool build(const sf::Image& ball, const sf::Image& brick, const sf::Image& paddle);
+
+    const sf::Image& getImage() const { return m_image; }
+    const sf::IntRect& getRect(AtlasSprite sprite) const { return m_rects[static_cast<std::size_t>(sprite)]; }
+    float getDensity() const { return m_density; }
+
+    static AtlasSprite brickSprite(Brick::HealthState state)
+    {
+        return static_cast<AtlasSprite>(static_cast<int>(AtlasSprite::BrickLow) + state);
+    }
+
+private:
+    sf::Image m_image;
+    std::array<sf::IntRect, SPRITE_COUNT> m_rects{};
+    float m_density{0.f};
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "LinkConditioner.hpp"
+#include <SFML/Network.hpp>
+#include <cstddef>
+#include <cstdint>
+
+// Non-blocking UDP link to one peer, for VersusSession packets. Outgoing
+// datagrams go through a LinkConditioner first, so latency, jitter and loss
+// can be added on top of the real network (or of loopback, for testing).
+class UdpLink
+{
+public:
+    static constexpr unsigned short DEFAULT_PORT{47000}; // Player 0; player 1 uses the next one
+
+    struct Stats
+    {
+        std::uint64_t sent{0};     // Handed to the socket
+        std::uint64_t received{0};
+        std::uint64_t ignored{0};  // From another sender
+        std::uint64_t errors{0};   // Socket send failures
+    };
+
+    // Bind localPort and send to peer:peerPort; false if the port is taken
+    bool open(unsigned short localPort, const sf::IpAddress& peer, unsigned short peerPort);
+    void close();
+
+    void setConditions(const LinkConditioner::Conditions& conditions) { m_conditioner.setConditions(conditions); }
+
+    // Queue a datagram; it leaves in update() once its delay has passed
+    void send(const unsigned char* data, std::size_t size);
+    // Send the datagrams that are due; call once per frame
+    void update();
+    // Next datagram from the peer, false if none is waiting
+    bool receive(unsigned char* out, std::size_t capacity, std::size_t& size);
+
+    const Stats& getStats() const { return m_stats; }
+    const LinkConditioner::Stats& getConditionerStats() const { return m_conditioner.getStats(); }
+
+private:
+    sf::UdpSocket m_socket;
+    sf::IpAddress m_peer;
+    unsigned short m_peerPort{0};
+    LinkConditioner m_conditioner;
+    Stats m_stats;
+};
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Simulation.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Two-player versus with rollback, independent of the transport. Both players
+// race through the same level on a field of their own, and every peer steps
+// both fields every tick: its own with the local input, the other with the
+// remote input if it has arrived, or a prediction of it (the last known input,
+// without launches and multi-balls). When the real input of a predicted tick
+// arrives and differs, both fields go back to their snapshots from before that
+// tick and are stepped again up to the present. Once the match is decided both
+// fields freeze, so every peer ends on the same state whatever it predicted.
+//
+// Inputs travel in packets from writePacket() / readPacket(). Every packet
+// repeats the inputs the peer has not acknowledged yet, so lost, duplicated or
+// reordered packets only delay them.
+class VersusSession
+{
+public:
+    static constexpr std::size_t MAX_ROLLBACK{16};      // Ticks the local side may run ahead of the remote input
+    static constexpr std::size_t INPUT_HISTORY{64};     // Local inputs kept until the peer acknowledges them
+    static constexpr std::size_t MAX_PACKET_INPUTS{32};
+    static constexpr std::size_t PACKET_INPUT_SIZE{6};  // Paddle target, launch, multi-ball
+    static constexpr std::size_t PACKET_HEADER_SIZE{13}; // Magic, acknowledged tick, first tick, input count
+    static constexpr std::size_t MAX_PACKET_SIZE{PACKET_HEADER_SIZE + MAX_PACKET_INPUTS * PACKET_INPUT_SIZE};
+
+    struct Stats
+    {
+        std::uint64_t ticks{0};           // advance() calls
+        std::uint64_t rollbacks{0};
+        std::uint64_t resimulatedTicks{0};
+        std::size_t maxRollbackDepth{0};
+        // Rollbacks by depth: the number of ticks they simulated again
+        std::array<std::uint64_t, MAX_ROLLBACK + 1> rollbackDepths{};
+        // Restoring and stepping both fields again, per rollback
+        double lastResimulationMicroseconds{0.0};
+        double maxResimulationMicroseconds{0.0};
+        double totalResimulationMicroseconds{0.0};
+        std::uint64_t packetsRead{0};
+        std::uint64_t packetsRejected{0}; // Not a versus packet
+    };
+
+    // Fields of player 0 and player 1; only the session steps them
+    VersusSession(Simulation& player0, Simulation& player1, int localPlayer);
+
+    // Both players start the same level on tick 0
+    void start();
+    void start(const BrickField& layout);
+    void start(const LevelView& level);
+
+    // False while the local side is MAX_ROLLBACK ticks ahead of the remote
+    // input, or has too many inputs unacknowledged: wait for the peer
+    bool canAdvance() const;
+    // Roll back if a misprediction came in, then simulate the next tick with
+    // this local input and the remote one (known or predicted)
+    void advance(const SimulationInput& localInput);
+    // Roll back now if a misprediction came in, without a new tick (to learn
+    // the real outcome once the local side has stopped advancing)
+    void settle();
+
+    // Packet for the peer: our unacknowledged inputs and what we received.
+    // Returns its size (at most MAX_PACKET_SIZE); nothing is written if
+    // capacity is smaller.
+    std::size_t writePacket(unsigned char* out, std::size_t capacity) const;
+    // Take in a packet from the peer; false if it was not one
+    bool readPacket(const unsigned char* data, std::size_t size);
+
+    std::uint64_t getTick() const { return m_tick; }
+    // Remote input is known for every tick up to this one
+    std::uint64_t getConfirmedTick() const { return m_confirmedTick; }
+    // The peer has every local input up to this tick
+    std::uint64_t getAcknowledgedTick() const { return m_remoteAck; }
+    // Nothing predicted shaped the current state: it is final
+    bool isSettled() const;
+    // A player cleared the level, or both lost their last life
+    bool isFinished() const;
+    // Once finished: the player who cleared the level, or else the better
+    // score; -1 for a draw or while the match goes on
+    int getWinner() const;
+
+    int getLocalPlayer() const { return m_localPlayer; }
+    const Simulation& getPlayer(int player) const { return *m_players[player]; }
+    // Combined state hash of both fields, for desync checks between peers
+    std::uint64_t computeStateHash() const;
+    const Stats& getStats() const { return m_stats; }
+
+private:
+    static constexpr std::size_t SNAPSHOTS{MAX_ROLLBACK + 1};
+
+    std::array<Simulation*, 2> m_players;
+    int m_localPlayer;
+
+    std::uint64_t m_tick{0};          // Ticks simulated
+    std::uint64_t m_steppedTick{0};   // Last tick that stepped the fields (later ones found the match over)
+    std::uint64_t m_confirmedTick{0}; // Remote inputs received without a gap
+    std::uint64_t m_remoteAck{0};     // Local inputs the peer has received without a gap
+    std::uint64_t m_rollbackFrom{0};  // First mispredicted tick, 0 if none
+
+    // By tick modulo the array size
+    std::array<SimulationInput, INPUT_HISTORY> m_localInputs{};
+    std::array<SimulationInput, INPUT_HISTORY> m_remoteInputs{};
+    std::array<std::uint64_t, INPUT_HISTORY> m_remoteInputTicks{}; // Tick held by each m_remoteInputs slot
+    std::array<SimulationInput, INPUT_HISTORY> m_usedRemoteInputs{}; // What each simulated tick was given
+    // State of each field after a tick, back to the one before the oldest tick that may still roll back
+    std::array<std::array<SimulationSnapshot, SNAPSHOTS>, 2> m_snapshots;
+
+    Stats m_stats;
+
+    void reset();
+    SimulationInput remoteInputFor(std::uint64_t tick) const;
+    void simulate(std::uint64_t tick);
+    void rollBack();
+};
@@ -0,0 +1,106 @@
+#include "AssetLoader.hpp"
+
+AssetLoader::AssetLoader()
+    : m_worker(&AssetLoader::run, this)
+{
+}
+
+AssetLoader::~AssetLoader()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_one();
+    m_worker.join();
+}
+
+AssetHandle<sf::Font> AssetLoader::loadFont(std::vector<std::string> candidatePaths)
+{
+    return enqueue<sf::Font>([paths = std::move(candidatePaths)]()
+    {
+        auto font = std::make_unique<sf::Font>();
+        for (const auto& path : paths)
+        {
+            if (font->loadFromFile(path))
+            {
+                return font;
+            }
+        }
+        return std::unique_ptr<sf::Font>();
+    });
+}
+
+AssetHandle<sf::Image> AssetLoader::loadImage(const std::string& path)
+{
+    return enqueue<sf::Image>([path]()
+    {
+        auto image = std::make_unique<sf::Image>();
+        if (!image->loadFromFile(path))
+        {
+            image.reset();
+        }
+        return image;
+    });
+}
+
+AssetHandle<TextureAtlas> AssetLoader::loadAtlas(const std::string& ballPath, const std::string& brickPath,
+                                                 const std::string& paddlePath)
+{
+    return enqueue<TextureAtlas>([ballPath, brickPath, paddlePath]()
+    {
+        sf::Image ball, brick, paddle;
+        auto atlas = std::make_unique<TextureAtlas>();
+        if (!ball.loadFromFile(ballPath) || !brick.loadFromFile(brickPath) || !paddle.loadFromFile(paddlePath) ||
+            !atlas->build(ball, brick, paddle))
+        {
+            atlas.reset();
+        }
+        return atlas;
+    });
+}
+
+AssetHandle<BrickField> AssetLoader::loadLevel(const LevelPack& pack, std::size_t index, float playfieldWidth)
+{
+    LevelView level = pack.getLevel(index);
+    return enqueue<BrickField>([level, playfieldWidth]()
+    {
+        auto bricks = std::make_unique<BrickField>();
+        bricks->reserve(static_cast<std::size_t>(level.cols) * level.rows);
+        level.appendBricks(*bricks, playfieldWidth);
+        return bricks;
+    });
+}
+
+template <typename T>
+AssetHandle<T> AssetLoader::enqueue(std::function<std::unique_ptr<T>()> load)
+{
+    // std::function needs a copyable target, so the task is shared
+    auto task = std::make_shared<std::packaged_task<std::unique_ptr<T>()>>(std::move(load));
+    AssetHandle<T> handle(task->get_future());
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.emplace_back([task]() { (*task)(); });
+    }
+    m_wake.notify_one();
+    return handle;
+}
+
+void AssetLoader::run()
+{
+    for (;;)
+    {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+            if (m_stopping)
+            {
+                return; // Pending jobs are dropped; their handles report a broken promise
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+        job();
+    }
+}
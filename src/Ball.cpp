@@ -1,4 +1,5 @@
 #include "Ball.hpp"
+#include "Collision.hpp"
 #include <cmath>
 #include <algorithm>
 
@@ -39,27 +40,7 @@ void Ball::draw(sf::RenderWindow& window) const
 
 void Ball::bounceOffWalls(float windowWidth, float windowHeight)
 {
-    float centerX = m_position.x + m_radius;
-    float centerY = m_position.y + m_radius;
-
-    // Left wall
-    if (centerX - m_radius <= 0.f && m_velocity.x < 0.f)
-    {
-        m_velocity.x = -m_velocity.x;
-        m_position.x = m_radius;
-    }
-    // Right wall
-    else if (centerX + m_radius >= windowWidth && m_velocity.x > 0.f)
-    {
-        m_velocity.x = -m_velocity.x;
-        m_position.x = windowWidth - m_radius * 2.f;
-    }
-    // Top wall
-    if (centerY - m_radius <= 0.f && m_velocity.y < 0.f)
-    {
-        m_velocity.y = -m_velocity.y;
-        m_position.y = m_radius;
-    }
+    collision::bounceOffWalls(m_position, m_velocity, m_radius, windowWidth);
 }
 
 bool Ball::isOutOfBounds(float windowHeight) const
@@ -74,57 +55,10 @@ sf::Vector2f Ball::getCenter() const
 
 bool Ball::checkCollisionWithAABB(const sf::FloatRect& aabb)
 {
-    sf::Vector2f center = getCenter();
-    
-    // Find closest point on AABB to circle center
-    float closestX = std::max(aabb.left, std::min(center.x, aabb.left + aabb.width));
-    float closestY = std::max(aabb.top, std::min(center.y, aabb.top + aabb.height));
-    
-    // Calculate distance from circle center to closest point
-    float dx = center.x - closestX;
-    float dy = center.y - closestY;
-    float distanceSquared = dx * dx + dy * dy;
-    
-    return distanceSquared < (m_radius * m_radius);
+    return collision::circleIntersectsAABB(m_position, m_radius, aabb);
 }
 
 void Ball::handleCollisionWithAABB(const sf::FloatRect& aabb)
 {
-    sf::Vector2f center = getCenter();
-    sf::Vector2f aabbCenter(aabb.left + aabb.width / 2.f, aabb.top + aabb.height / 2.f);
-    
-    // Determine collision side
-    float dx = center.x - aabbCenter.x;
-    float dy = center.y - aabbCenter.y;
-    
-    float overlapX = m_radius + aabb.width / 2.f - std::abs(dx);
-    float overlapY = m_radius + aabb.height / 2.f - std::abs(dy);
-    
-    if (overlapX < overlapY)
-    {
-        // Horizontal collision
-        m_velocity.x = -m_velocity.x;
-        if (dx > 0)
-        {
-            m_position.x = aabb.left + aabb.width + m_radius;
-        }
-        else
-        {
-            m_position.x = aabb.left - m_radius * 2.f;
-        }
-    }
-    else
-    {
-        // Vertical collision
-        m_velocity.y = -m_velocity.y;
-        if (dy > 0)
-        {
-            m_position.y = aabb.top + aabb.height + m_radius;
-        }
-        else
-        {
-            m_position.y = aabb.top - m_radius * 2.f;
-        }
-    }
+    collision::resolveCircleAABB(m_position, m_velocity, m_radius, aabb);
 }
-
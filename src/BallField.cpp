@@ -0,0 +1,120 @@
+#include "BallField.hpp"
+#include <cstring>
+
+BallField::BallField(float radius)
+    : m_radius(radius)
+{
+}
+
+void BallField::clear()
+{
+    m_x.clear();
+    m_y.clear();
+    m_vx.clear();
+    m_vy.clear();
+    m_previousX.clear();
+    m_previousY.clear();
+    m_gravity.clear();
+}
+
+void BallField::reserve(std::size_t count)
+{
+    m_x.reserve(count);
+    m_y.reserve(count);
+    m_vx.reserve(count);
+    m_vy.reserve(count);
+    m_previousX.reserve(count);
+    m_previousY.reserve(count);
+    m_gravity.reserve(count);
+}
+
+std::size_t BallField::spawn(const sf::Vector2f& position, const sf::Vector2f& velocity, bool gravityEnabled)
+{
+    m_x.push_back(position.x);
+    m_y.push_back(position.y);
+    m_vx.push_back(velocity.x);
+    m_vy.push_back(velocity.y);
+    m_previousX.push_back(position.x);
+    m_previousY.push_back(position.y);
+    m_gravity.push_back(gravityEnabled ? 1 : 0);
+    return m_x.size() - 1;
+}
+
+void BallField::remove(std::size_t index)
+{
+    std::size_t last = m_x.size() - 1;
+    m_x[index] = m_x[last];
+    m_y[index] = m_y[last];
+    m_vx[index] = m_vx[last];
+    m_vy[index] = m_vy[last];
+    m_previousX[index] = m_previousX[last];
+    m_previousY[index] = m_previousY[last];
+    m_gravity[index] = m_gravity[last];
+
+    m_x.pop_back();
+    m_y.pop_back();
+    m_vx.pop_back();
+    m_vy.pop_back();
+    m_previousX.pop_back();
+    m_previousY.pop_back();
+    m_gravity.pop_back();
+}
+
+void BallField::setPosition(std::size_t index, const sf::Vector2f& position)
+{
+    m_x[index] = position.x;
+    m_y[index] = position.y;
+}
+
+void BallField::setVelocity(std::size_t index, const sf::Vector2f& velocity)
+{
+    m_vx[index] = velocity.x;
+    m_vy[index] = velocity.y;
+}
+
+void BallField::storePreviousPositions()
+{
+    m_previousX = m_x;
+    m_previousY = m_y;
+}
+
+void BallField::saveState(unsigned char* out) const
+{
+    auto write = [&out](const auto& column)
+    {
+        std::size_t bytes = column.size() * sizeof(column[0]);
+        if (bytes > 0)
+        {
+            std::memcpy(out, column.data(), bytes);
+        }
+        out += bytes;
+    };
+    write(m_x);
+    write(m_y);
+    write(m_vx);
+    write(m_vy);
+    write(m_previousX);
+    write(m_previousY);
+    write(m_gravity);
+}
+
+void BallField::restoreState(const unsigned char* in, std::size_t count)
+{
+    auto read = [&in, count](auto& column)
+    {
+        column.resize(count);
+        std::size_t bytes = count * sizeof(column[0]);
+        if (bytes > 0)
+        {
+            std::memcpy(column.data(), in, bytes);
+        }
+        in += bytes;
+    };
+    read(m_x);
+    read(m_y);
+    read(m_vx);
+    read(m_vy);
+    read(m_previousX);
+    read(m_previousY);
+    read(m_gravity);
+}
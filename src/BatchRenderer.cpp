@@ -0,0 +1,199 @@
+#include "BatchRenderer.hpp"
+#include "Brick.hpp"
+#include <cmath>
+
+namespace
+{
+constexpr float BRICK_OUTLINE{1.f};
+constexpr float PADDLE_OUTLINE{2.f};
+constexpr std::size_t PADDLE_VERTICES{BatchRenderer::VERTICES_PER_RECT * 2};
+constexpr std::size_t BALL_VERTICES{BatchRenderer::BALL_SEGMENTS * 3};
+
+sf::Vector2f lerp(const sf::Vector2f& from, const sf::Vector2f& to, float alpha)
+{
+    return from + (to - from) * alpha;
+}
+
+sf::FloatRect grow(const sf::FloatRect& rect, float amount)
+{
+    return sf::FloatRect(rect.left - amount, rect.top - amount,
+                         rect.width + amount * 2.f, rect.height + amount * 2.f);
+}
+} // namespace
+
+BatchRenderer::BatchRenderer()
+    : m_vertices(sf::Triangles, PADDLE_VERTICES)
+{
+    m_circle.reserve(BALL_SEGMENTS);
+    for (std::size_t i = 0; i < BALL_SEGMENTS; ++i)
+    {
+        float angle = static_cast<float>(i) * 2.f * 3.14159265f / static_cast<float>(BALL_SEGMENTS);
+        m_circle.emplace_back(std::cos(angle), std::sin(angle));
+    }
+}
+
+void BatchRenderer::update(const Simulation& simulation, float alpha)
+{
+    const Paddle& paddle = simulation.getPaddle();
+    update(simulation.getBricks(), simulation.getBalls(),
+           sf::FloatRect(simulation.getPreviousPaddlePosition(), paddle.getSize()),
+           sf::FloatRect(paddle.getPosition(), paddle.getSize()), alpha);
+}
+
+void BatchRenderer::update(const RenderSnapshot& snapshot, float alpha)
+{
+    update(snapshot.bricks, snapshot.balls, sf::FloatRect(snapshot.previousPaddlePosition, snapshot.paddleSize),
+           sf::FloatRect(snapshot.paddlePosition, snapshot.paddleSize), alpha);
+}
+
+void BatchRenderer::update(const BrickField& bricks, const BallField& balls, const sf::FloatRect& previousPaddle,
+                           const sf::FloatRect& paddle, float alpha)
+{
+    m_lastRebuiltBricks = 0;
+
+    if (m_bricksStale || bricks.getGeneration() != m_brickGeneration || bricks.getRewindCount() != m_brickRewinds ||
+        bricks.size() != m_brickCount)
+    {
+        rebuildAllBricks(bricks);
+    }
+    else
+    {
+        // Only rewrite bricks hit since the last update
+        const std::vector<std::uint32_t>& changes = bricks.getChangeLog();
+        for (; m_changeLogCursor < changes.size(); ++m_changeLogCursor)
+        {
+            writeBrick(bricks, changes[m_changeLogCursor]);
+            ++m_lastRebuiltBricks;
+        }
+    }
+
+    // Paddle and balls follow the bricks; the ball count may change every step
+    std::size_t tail = m_brickCount * VERTICES_PER_BRICK;
+    m_vertices.resize(tail + PADDLE_VERTICES + balls.size() * BALL_VERTICES);
+    writePaddle(tail, previousPaddle, paddle, alpha);
+    writeBalls(tail + PADDLE_VERTICES, balls, alpha);
+}
+
+void BatchRenderer::setAtlas(const sf::Texture& texture, const TextureAtlas& atlas)
+{
+    m_texture = &texture;
+    for (std::size_t i = 0; i < TextureAtlas::SPRITE_COUNT; ++i)
+    {
+        // Sample texel centres only, so filtering never reaches a neighbour
+        sf::FloatRect rect(atlas.getRect(static_cast<AtlasSprite>(i)));
+        m_textureRects[i] = sf::FloatRect(rect.left + 0.5f, rect.top + 0.5f, rect.width - 1.f, rect.height - 1.f);
+    }
+    m_bricksStale = true;
+}
+
+void BatchRenderer::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    states.texture = m_texture;
+    target.draw(m_vertices, states);
+}
+
+void BatchRenderer::rebuildAllBricks(const BrickField& bricks)
+{
+    m_brickCount = bricks.size();
+    m_brickGeneration = bricks.getGeneration();
+    m_brickRewinds = bricks.getRewindCount();
+    m_changeLogCursor = bricks.getChangeLog().size();
+    m_bricksStale = false;
+
+    m_vertices.resize(m_brickCount * VERTICES_PER_BRICK + PADDLE_VERTICES);
+    for (std::size_t i = 0; i < m_brickCount; ++i)
+    {
+        writeBrick(bricks, i);
+    }
+    m_lastRebuiltBricks = m_brickCount;
+}
+
+void BatchRenderer::writeBrick(const BrickField& bricks, std::size_t index)
+{
+    std::size_t first = index * VERTICES_PER_BRICK;
+    if (!bricks.isAlive(index))
+    {
+        collapse(first, VERTICES_PER_BRICK);
+        return;
+    }
+
+    sf::FloatRect aabb = bricks.getAABB(index);
+    Brick::HealthState state = Brick::healthState(bricks.getHealth(index), bricks.getMaxHealth(index));
+    writeRect(first, grow(aabb, BRICK_OUTLINE), sf::Color::White, textureRect(AtlasSprite::White));
+    if (m_texture)
+    {
+        // The tint is baked into the sprite of each health state
+        writeRect(first + VERTICES_PER_RECT, aabb, sf::Color::White, textureRect(TextureAtlas::brickSprite(state)));
+    }
+    else
+    {
+        writeRect(first + VERTICES_PER_RECT, aabb, Brick::colorForState(state), textureRect(AtlasSprite::White));
+    }
+}
+
+void BatchRenderer::writeRect(std::size_t first, const sf::FloatRect& rect, const sf::Color& color,
+                              const sf::FloatRect& textureRect)
+{
+    sf::Vector2f topLeft(rect.left, rect.top);
+    sf::Vector2f topRight(rect.left + rect.width, rect.top);
+    sf::Vector2f bottomRight(rect.left + rect.width, rect.top + rect.height);
+    sf::Vector2f bottomLeft(rect.left, rect.top + rect.height);
+
+    sf::Vector2f texTopLeft(textureRect.left, textureRect.top);
+    sf::Vector2f texTopRight(textureRect.left + textureRect.width, textureRect.top);
+    sf::Vector2f texBottomRight(textureRect.left + textureRect.width, textureRect.top + textureRect.height);
+    sf::Vector2f texBottomLeft(textureRect.left, textureRect.top + textureRect.height);
+
+    sf::Vertex* v = &m_vertices[first];
+    v[0] = sf::Vertex(topLeft, color, texTopLeft);
+    v[1] = sf::Vertex(topRight, color, texTopRight);
+    v[2] = sf::Vertex(bottomRight, color, texBottomRight);
+    v[3] = sf::Vertex(topLeft, color, texTopLeft);
+    v[4] = sf::Vertex(bottomRight, color, texBottomRight);
+    v[5] = sf::Vertex(bottomLeft, color, texBottomLeft);
+}
+
+void BatchRenderer::writePaddle(std::size_t first, const sf::FloatRect& previous, const sf::FloatRect& current,
+                                float alpha)
+{
+    sf::Vector2f position = lerp(previous.getPosition(), current.getPosition(), alpha);
+    sf::FloatRect bounds(position, current.getSize());
+    writeRect(first, grow(bounds, PADDLE_OUTLINE), sf::Color::Cyan, textureRect(AtlasSprite::White));
+    writeRect(first + VERTICES_PER_RECT, bounds, sf::Color::White, textureRect(AtlasSprite::Paddle));
+}
+
+void BatchRenderer::writeBalls(std::size_t first, const BallField& balls, float alpha)
+{
+    float radius = balls.getRadius();
+
+    // The fan maps onto the disc inscribed in the ball sprite
+    const sf::FloatRect& sprite = textureRect(AtlasSprite::Ball);
+    sf::Vector2f texCenter(sprite.left + sprite.width / 2.f, sprite.top + sprite.height / 2.f);
+    sf::Vector2f texRadius(sprite.width / 2.f, sprite.height / 2.f);
+
+    for (std::size_t ball = 0; ball < balls.size(); ++ball)
+    {
+        sf::Vector2f position = lerp(balls.getPreviousPosition(ball), balls.getPosition(ball), alpha);
+        sf::Vector2f center = position + sf::Vector2f(radius, radius);
+        sf::Vertex* v = &m_vertices[first + ball * BALL_VERTICES];
+        for (std::size_t i = 0; i < BALL_SEGMENTS; ++i, v += 3)
+        {
+            const sf::Vector2f& from = m_circle[i];
+            const sf::Vector2f& to = m_circle[(i + 1) % BALL_SEGMENTS];
+            v[0] = sf::Vertex(center, sf::Color::White, texCenter);
+            v[1] = sf::Vertex(center + from * radius, sf::Color::White,
+                              texCenter + sf::Vector2f(from.x * texRadius.x, from.y * texRadius.y));
+            v[2] = sf::Vertex(center + to * radius, sf::Color::White,
+                              texCenter + sf::Vector2f(to.x * texRadius.x, to.y * texRadius.y));
+        }
+    }
+}
+
+void BatchRenderer::collapse(std::size_t first, std::size_t count)
+{
+    // Degenerate triangles cover no pixels, so slots stay allocated but invisible
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        m_vertices[first + i] = sf::Vertex(sf::Vector2f(0.f, 0.f), sf::Color::Transparent);
+    }
+}
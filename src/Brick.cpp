@@ -44,28 +44,42 @@ void Brick::draw(sf::RenderWindow& window) const
 
 sf::Color Brick::getColorForHealth() const
 {
-    if (m_health <= 0)
+    return colorForHealth(m_health, m_maxHealth);
+}
+
+sf::Color Brick::colorForHealth(int health, int maxHealth)
+{
+    if (health <= 0)
     {
         return sf::Color::Transparent;
     }
+    return colorForState(healthState(health, maxHealth));
+}
 
-    float healthRatio = static_cast<float>(m_health) / static_cast<float>(m_maxHealth);
-    
+sf::Color Brick::colorForState(HealthState state)
+{
     // Color gradient: Red (low health) -> Yellow -> Green (high health)
-    if (healthRatio > 0.66f)
+    switch (state)
     {
-        // Green
+    case HIGH_HEALTH:
         return sf::Color(0, 255, 0);
+    case MEDIUM_HEALTH:
+        return sf::Color(255, 255, 0);
+    default:
+        return sf::Color(255, 0, 0);
     }
-    else if (healthRatio > 0.33f)
+}
+
+Brick::HealthState Brick::healthState(int health, int maxHealth)
+{
+    float healthRatio = static_cast<float>(health) / static_cast<float>(maxHealth);
+    if (healthRatio > 0.66f)
     {
-        // Yellow
-        return sf::Color(255, 255, 0);
+        return HIGH_HEALTH;
     }
-    else
+    if (healthRatio > 0.33f)
     {
-        // Red
-        return sf::Color(255, 0, 0);
+        return MEDIUM_HEALTH;
     }
+    return LOW_HEALTH;
 }
-
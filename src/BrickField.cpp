@@ -0,0 +1,158 @@
+#include "BrickField.hpp"
+#include <algorithm>
+
+namespace
+{
+// Bricks tougher than any pack level (e.g. the bench's unbreakable walls)
+// must not reserve millions of entries each
+constexpr std::int32_t MAX_RESERVED_HEALTH{15};
+} // namespace
+
+void BrickField::clear()
+{
+    m_x.clear();
+    m_y.clear();
+    m_width.clear();
+    m_height.clear();
+    m_health.clear();
+    m_maxHealth.clear();
+    m_alive.clear();
+    m_aliveCount = 0;
+    m_changeLog.clear();
+    m_changedFrom.clear();
+    ++m_generation;
+}
+
+void BrickField::reserve(std::size_t count)
+{
+    m_x.reserve(count);
+    m_y.reserve(count);
+    m_width.reserve(count);
+    m_height.reserve(count);
+    m_health.reserve(count);
+    m_maxHealth.reserve(count);
+    m_alive.reserve((count + 63) / 64);
+}
+
+void BrickField::reserveChangeLog()
+{
+    // One entry per point of health, plus one for a destroy() on a damaged brick
+    std::size_t entries = m_changeLog.size();
+    for (std::size_t i = 0; i < m_health.size(); ++i)
+    {
+        entries += static_cast<std::size_t>(std::min(m_health[i], MAX_RESERVED_HEALTH)) + 1;
+    }
+    m_changeLog.reserve(entries);
+    m_changedFrom.reserve(entries);
+}
+
+void BrickField::syncFrom(const BrickField& source)
+{
+    if (m_generation != source.m_generation || m_rewinds != source.m_rewinds || size() != source.size() ||
+        m_changeLog.size() > source.m_changeLog.size())
+    {
+        *this = source;
+        // Later syncs append without allocating
+        m_changeLog.reserve(source.m_changeLog.capacity());
+        m_changedFrom.reserve(source.m_changedFrom.capacity());
+        return;
+    }
+
+    for (std::size_t i = m_changeLog.size(); i < source.m_changeLog.size(); ++i)
+    {
+        std::uint32_t index = source.m_changeLog[i];
+        m_health[index] = source.m_health[index];
+        bool alive = isAlive(index);
+        if (alive && !source.isAlive(index))
+        {
+            markDead(index);
+        }
+        else if (!alive && source.isAlive(index))
+        {
+            markAlive(index); // Rewound
+        }
+        logChange(index, source.m_changedFrom[i]);
+    }
+}
+
+bool BrickField::rewindTo(std::size_t changeCount)
+{
+    if (changeCount >= m_changeLog.size())
+    {
+        return false;
+    }
+
+    // Newest first, so each brick ends at its oldest logged value past changeCount
+    bool revived = false;
+    for (std::size_t i = m_changeLog.size(); i > changeCount; --i)
+    {
+        std::uint32_t index = m_changeLog[i - 1];
+        std::int32_t health = m_changedFrom[i - 1];
+        m_health[index] = health;
+        if (health > 0 && !isAlive(index))
+        {
+            markAlive(index);
+            revived = true;
+        }
+        else if (health <= 0 && isAlive(index))
+        {
+            markDead(index);
+        }
+    }
+    m_changeLog.resize(changeCount);
+    m_changedFrom.resize(changeCount);
+    ++m_rewinds;
+    return revived;
+}
+
+std::size_t BrickField::add(float x, float y, float width, float height, int maxHealth)
+{
+    std::size_t index = m_x.size();
+    m_x.push_back(x);
+    m_y.push_back(y);
+    m_width.push_back(width);
+    m_height.push_back(height);
+    m_health.push_back(maxHealth);
+    m_maxHealth.push_back(maxHealth);
+
+    if ((index & 63) == 0)
+    {
+        m_alive.push_back(0);
+    }
+    if (maxHealth > 0)
+    {
+        m_alive[index >> 6] |= std::uint64_t{1} << (index & 63);
+        ++m_aliveCount;
+    }
+    return index;
+}
+
+bool BrickField::takeDamage(std::size_t index, int damage)
+{
+    if (!isAlive(index))
+    {
+        return false;
+    }
+
+    logChange(index, m_health[index]);
+    m_health[index] -= damage;
+    if (m_health[index] <= 0)
+    {
+        m_health[index] = 0;
+        markDead(index);
+        return true;
+    }
+    return false;
+}
+
+void BrickField::destroy(std::size_t index)
+{
+    if (isAlive(index))
+    {
+        logChange(index, m_health[index]);
+        m_health[index] = 0;
+        markDead(index);
+        return;
+    }
+    m_health[index] = 0;
+}
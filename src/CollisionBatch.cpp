@@ -0,0 +1,182 @@
+#include "CollisionBatch.hpp"
+#include "CollisionBatchKernel.hpp"
+
+#if CASSEBRIQUES_X86_SIMD
+#include <emmintrin.h>
+#endif
+
+namespace collision
+{
+namespace detail
+{
+#if CASSEBRIQUES_X86_SIMD
+// CollisionBatchAvx2.cpp, built for AVX2; only called when the CPU has it
+void sweepLanesAvx2(const sf::Vector2f& center, const sf::Vector2f& displacement, float radius,
+                   const BoxBatch& boxes, SweepLanes& lanes);
+#endif
+} // namespace detail
+
+namespace
+{
+#if CASSEBRIQUES_X86_SIMD
+// SSE2 is part of x86-64, so this path needs no runtime check there
+struct Sse2
+{
+    using V = __m128;
+    static constexpr std::size_t WIDTH{4};
+
+    static V set1(float value) { return _mm_set1_ps(value); }
+    static V load(const float* values) { return _mm_load_ps(values); }
+    static void store(float* values, V v) { _mm_store_ps(values, v); }
+    static V add(V a, V b) { return _mm_add_ps(a, b); }
+    static V sub(V a, V b) { return _mm_sub_ps(a, b); }
+    static V mul(V a, V b) { return _mm_mul_ps(a, b); }
+    static V div(V a, V b) { return _mm_div_ps(a, b); }
+    static V sqrt(V a) { return _mm_sqrt_ps(a); }
+    static V abs(V a) { return _mm_andnot_ps(_mm_set1_ps(-0.f), a); }
+    static V negate(V a) { return _mm_xor_ps(a, _mm_set1_ps(-0.f)); }
+    // minps / maxps return their second operand on ties and NaN, like std::min / std::max
+    // with the operands swapped
+    static V stdMin(V a, V b) { return _mm_min_ps(b, a); }
+    static V stdMax(V a, V b) { return _mm_max_ps(b, a); }
+    static V lt(V a, V b) { return _mm_cmplt_ps(a, b); }
+    static V le(V a, V b) { return _mm_cmple_ps(a, b); }
+    static V gt(V a, V b) { return _mm_cmpgt_ps(a, b); }
+    static V ge(V a, V b) { return _mm_cmpge_ps(a, b); }
+    static V andMask(V a, V b) { return _mm_and_ps(a, b); }
+    static V orMask(V a, V b) { return _mm_or_ps(a, b); }
+    static V notMask(V a) { return _mm_xor_ps(a, _mm_castsi128_ps(_mm_set1_epi32(-1))); }
+    static V select(V mask, V a, V b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+    static int movemask(V mask) { return _mm_movemask_ps(mask); }
+};
+#endif
+
+// Reference: the scalar kernel box by box
+void sweepLanesScalar(const sf::Vector2f& center, const sf::Vector2f& displacement, float radius,
+                      const BoxBatch& boxes, detail::SweepLanes& lanes)
+{
+    for (std::size_t i = 0; i < boxes.count; ++i)
+    {
+        SweepHit hit;
+        if (sweepCircleBox(BoxShape{boxes.width[i], boxes.height[i], radius}, center, displacement, boxes.left[i],
+                           boxes.top[i], hit))
+        {
+            lanes.found |= 1u << i;
+            lanes.inside |= hit.startedInside ? 1u << i : 0u;
+            lanes.time[i] = hit.time;
+            lanes.normalX[i] = hit.normal.x;
+            lanes.normalY[i] = hit.normal.y;
+        }
+    }
+}
+
+bool hasAvx2()
+{
+#if CASSEBRIQUES_X86_SIMD
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+SweepBatchPath selectPath()
+{
+    if (hasAvx2())
+    {
+        return SweepBatchPath::Avx2;
+    }
+    return isSweepBatchPathSupported(SweepBatchPath::Sse2) ? SweepBatchPath::Sse2 : SweepBatchPath::Scalar;
+}
+} // namespace
+
+bool isSweepBatchPathSupported(SweepBatchPath path)
+{
+    switch (path)
+    {
+    case SweepBatchPath::Scalar:
+        return true;
+    case SweepBatchPath::Sse2:
+        return CASSEBRIQUES_X86_SIMD != 0;
+    case SweepBatchPath::Avx2:
+        return hasAvx2();
+    }
+    return false;
+}
+
+SweepBatchPath getSweepBatchPath()
+{
+    static const SweepBatchPath path = selectPath();
+    return path;
+}
+
+const char* getSweepBatchPathName(SweepBatchPath path)
+{
+    switch (path)
+    {
+    case SweepBatchPath::Scalar:
+        return "scalar";
+    case SweepBatchPath::Sse2:
+        return "sse2";
+    case SweepBatchPath::Avx2:
+        return "avx2";
+    }
+    return "?";
+}
+
+bool sweepCircleBoxes(const sf::Vector2f& center, const sf::Vector2f& displacement, float radius,
+                      const BoxBatch& boxes, SweepBatchHit& result)
+{
+    return sweepCircleBoxes(getSweepBatchPath(), center, displacement, radius, boxes, result);
+}
+
+bool sweepCircleBoxes(SweepBatchPath path, const sf::Vector2f& center, const sf::Vector2f& displacement,
+                      float radius, const BoxBatch& boxes, SweepBatchHit& result)
+{
+    detail::SweepLanes lanes;
+    switch (path)
+    {
+    case SweepBatchPath::Scalar:
+        sweepLanesScalar(center, displacement, radius, boxes, lanes);
+        break;
+#if CASSEBRIQUES_X86_SIMD
+    case SweepBatchPath::Sse2:
+        detail::sweepLanes<Sse2>(center, displacement, radius, boxes, lanes);
+        break;
+    case SweepBatchPath::Avx2:
+        detail::sweepLanesAvx2(center, displacement, radius, boxes, lanes);
+        break;
+#else
+    default:
+        sweepLanesScalar(center, displacement, radius, boxes, lanes);
+        break;
+#endif
+    }
+
+    // Boxes past count hold stale values: ignore whatever they returned
+    result.hitMask = lanes.found & ((1u << boxes.count) - 1u);
+    if (result.hitMask == 0)
+    {
+        return false;
+    }
+
+    // Earliest contact, first box on ties, as the scalar loop keeps it
+    std::size_t earliest = SWEEP_BATCH;
+    for (std::size_t i = 0; i < boxes.count; ++i)
+    {
+        if (((result.hitMask >> i) & 1u) && (earliest == SWEEP_BATCH || lanes.time[i] < lanes.time[earliest]))
+        {
+            earliest = i;
+        }
+    }
+    result.earliest = earliest;
+    result.hit.time = lanes.time[earliest];
+    result.hit.normal = sf::Vector2f(lanes.normalX[earliest], lanes.normalY[earliest]);
+    if ((lanes.corner >> earliest) & 1u)
+    {
+        result.hit.normal /= radius;
+    }
+    result.hit.startedInside = ((lanes.inside >> earliest) & 1u) != 0;
+    return true;
+}
+
+} // namespace collision
@@ -0,0 +1,57 @@
+// Only the functions marked AVX2_TARGET use AVX2: the file is not built with
+// -mavx2, so inline code it pulls in from headers stays safe on any x86-64.
+// Nothing here runs unless __builtin_cpu_supports("avx2") said so.
+#if CASSEBRIQUES_X86_SIMD
+#define AVX2_TARGET __attribute__((target("avx2")))
+#define CASSEBRIQUES_SWEEP_TARGET AVX2_TARGET
+#endif
+#include "CollisionBatchKernel.hpp"
+
+#if CASSEBRIQUES_X86_SIMD
+#include <immintrin.h>
+
+namespace collision
+{
+namespace detail
+{
+namespace
+{
+struct Avx2
+{
+    using V = __m256;
+    static constexpr std::size_t WIDTH{8};
+
+    AVX2_TARGET static V set1(float value) { return _mm256_set1_ps(value); }
+    AVX2_TARGET static V load(const float* values) { return _mm256_load_ps(values); }
+    AVX2_TARGET static void store(float* values, V v) { _mm256_store_ps(values, v); }
+    AVX2_TARGET static V add(V a, V b) { return _mm256_add_ps(a, b); }
+    AVX2_TARGET static V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+    AVX2_TARGET static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+    AVX2_TARGET static V div(V a, V b) { return _mm256_div_ps(a, b); }
+    AVX2_TARGET static V sqrt(V a) { return _mm256_sqrt_ps(a); }
+    AVX2_TARGET static V abs(V a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a); }
+    AVX2_TARGET static V negate(V a) { return _mm256_xor_ps(a, _mm256_set1_ps(-0.f)); }
+    // Same operand swap as the SSE2 version: ties and NaN go to the second operand
+    AVX2_TARGET static V stdMin(V a, V b) { return _mm256_min_ps(b, a); }
+    AVX2_TARGET static V stdMax(V a, V b) { return _mm256_max_ps(b, a); }
+    AVX2_TARGET static V lt(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    AVX2_TARGET static V le(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    AVX2_TARGET static V gt(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    AVX2_TARGET static V ge(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    AVX2_TARGET static V andMask(V a, V b) { return _mm256_and_ps(a, b); }
+    AVX2_TARGET static V orMask(V a, V b) { return _mm256_or_ps(a, b); }
+    AVX2_TARGET static V notMask(V a) { return _mm256_xor_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+    AVX2_TARGET static V select(V mask, V a, V b) { return _mm256_blendv_ps(b, a, mask); }
+    AVX2_TARGET static int movemask(V mask) { return _mm256_movemask_ps(mask); }
+};
+} // namespace
+
+AVX2_TARGET void sweepLanesAvx2(const sf::Vector2f& center, const sf::Vector2f& displacement, float radius,
+                               const BoxBatch& boxes, SweepLanes& lanes)
+{
+    sweepLanes<Avx2>(center, displacement, radius, boxes, lanes);
+}
+
+} // namespace detail
+} // namespace collision
+#endif
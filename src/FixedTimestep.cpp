@@ -0,0 +1,30 @@
+#include "FixedTimestep.hpp"
+#include <cmath>
+
+FixedTimestep::FixedTimestep(double stepSeconds, int maxStepsPerFrame)
+    : m_step(stepSeconds)
+    , m_maxSteps(maxStepsPerFrame)
+{
+}
+
+int FixedTimestep::advance(double frameSeconds)
+{
+    if (frameSeconds > 0.0)
+    {
+        m_accumulator += frameSeconds;
+    }
+
+    int steps = static_cast<int>(m_accumulator / m_step);
+    if (steps > m_maxSteps)
+    {
+        // Too far behind (hitch, debugger, window drag): run the capped number of
+        // steps and keep only the sub-step remainder so we do not spiral
+        steps = m_maxSteps;
+        m_accumulator = std::fmod(m_accumulator, m_step);
+        ++m_droppedFrames;
+        return steps;
+    }
+
+    m_accumulator -= steps * m_step;
+    return steps;
+}
@@ -0,0 +1,16 @@
+#include "FrameRenderer.hpp"
+
+void FrameRenderer::draw(sf::RenderTarget& target, const RenderSnapshot& snapshot, float alpha)
+{
+    target.clear(sf::Color::Black);
+
+    if (snapshot.state != Simulation::MENU)
+    {
+        // Bricks, paddle and ball in a single draw call
+        m_playfield.update(snapshot, alpha);
+        target.draw(m_playfield);
+    }
+
+    m_hud.update(snapshot.state, snapshot.lives, snapshot.score);
+    target.draw(m_hud);
+}
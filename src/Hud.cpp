@@ -0,0 +1,115 @@
+#include "Hud.hpp"
+#include <cstdio>
+#include <initializer_list>
+
+namespace
+{
+constexpr float WIDTH{static_cast<float>(Simulation::WINDOW_WIDTH)};
+constexpr float HEIGHT{static_cast<float>(Simulation::WINDOW_HEIGHT)};
+
+// Longer than any label + number, so number strings never outgrow their buffers
+const char* const NUMBER_CAPACITY = "Score final: -2147483648    ";
+
+void setupText(sf::Text& text, const char* string, unsigned int size, const sf::Color& color, float x, float y)
+{
+    text.setString(string);
+    text.setCharacterSize(size);
+    text.setFillColor(color);
+    text.setPosition(x, y);
+}
+} // namespace
+
+Hud::Hud()
+    : m_overlay(sf::Vector2f(WIDTH, HEIGHT))
+    , m_state(Simulation::MENU)
+{
+    setupText(m_title, "CASSE BRIQUES", 48, sf::Color::White, WIDTH / 2.f - 150.f, HEIGHT / 2.f - 100.f);
+    setupText(m_startPrompt, "Appuyez sur ENTREE pour commencer", 24, sf::Color::Yellow,
+              WIDTH / 2.f - 180.f, HEIGHT / 2.f + 50.f);
+    setupText(m_lives, NUMBER_CAPACITY, 20, sf::Color::White, 10.f, 10.f);
+    setupText(m_score, NUMBER_CAPACITY, 20, sf::Color::White, WIDTH - 200.f, 10.f);
+    setupText(m_gameOver, "GAME OVER", 64, sf::Color::Red, WIDTH / 2.f - 180.f, HEIGHT / 2.f - 100.f);
+    setupText(m_victory, "VICTOIRE!", 64, sf::Color::Green, WIDTH / 2.f - 160.f, HEIGHT / 2.f - 100.f);
+    setupText(m_finalScore, NUMBER_CAPACITY, 32, sf::Color::White, WIDTH / 2.f - 150.f, HEIGHT / 2.f);
+    setupText(m_restartPrompt, "Appuyez sur ENTREE pour revenir au menu", 20, sf::Color::Yellow,
+              WIDTH / 2.f - 200.f, HEIGHT / 2.f + 100.f);
+    m_overlay.setFillColor(sf::Color(0, 0, 0, 200));
+    m_scratch = NUMBER_CAPACITY;
+}
+
+void Hud::setFont(const sf::Font& font)
+{
+    for (sf::Text* text : {&m_title, &m_startPrompt, &m_lives, &m_score, &m_gameOver, &m_victory, &m_finalScore,
+                           &m_restartPrompt})
+    {
+        text->setFont(font);
+    }
+}
+
+void Hud::update(Simulation::GameState state, int lives, int score)
+{
+    m_lastRebuilt = 0;
+    m_state = state;
+
+    // Only the texts visible in this state are kept current
+    if (state == Simulation::PLAYING)
+    {
+        if (lives != m_shownLives)
+        {
+            setNumber(m_lives, "Vies: ", lives);
+            m_shownLives = lives;
+            ++m_lastRebuilt;
+        }
+        if (score != m_shownScore)
+        {
+            setNumber(m_score, "Score: ", score);
+            m_shownScore = score;
+            ++m_lastRebuilt;
+        }
+    }
+    else if ((state == Simulation::GAME_OVER || state == Simulation::VICTORY) && score != m_shownFinalScore)
+    {
+        setNumber(m_finalScore, "Score final: ", score);
+        m_shownFinalScore = score;
+        ++m_lastRebuilt;
+    }
+}
+
+void Hud::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    switch (m_state)
+    {
+    case Simulation::MENU:
+        target.draw(m_title, states);
+        target.draw(m_startPrompt, states);
+        break;
+
+    case Simulation::PLAYING:
+        target.draw(m_lives, states);
+        target.draw(m_score, states);
+        break;
+
+    case Simulation::GAME_OVER:
+    case Simulation::VICTORY:
+        target.draw(m_overlay, states);
+        target.draw(m_state == Simulation::GAME_OVER ? m_gameOver : m_victory, states);
+        target.draw(m_finalScore, states);
+        target.draw(m_restartPrompt, states);
+        break;
+    }
+}
+
+void Hud::setNumber(sf::Text& text, const char* label, int value)
+{
+    char buffer[48];
+    std::snprintf(buffer, sizeof(buffer), "%s%d", label, value);
+
+    // Append character by character: single characters never allocate, and
+    // assigning to the text reuses the capacity its placeholder reserved
+    m_scratch.clear();
+    for (const char* c = buffer; *c != '\0'; ++c)
+    {
+        m_scratch += sf::String(*c);
+    }
+    text.setString(m_scratch);
+}
@@ -10,27 +10,13 @@ void InputManager::processEvent(const sf::Event& event)
 {
     if (event.type == sf::Event::KeyPressed)
     {
-        auto it = m_keyBindings.find(event.key.code);
-        if (it != m_keyBindings.end())
-        {
-            for (const auto& callback : it->second)
-            {
-                callback();
-            }
-        }
+        m_events.publish(KeyPressedEvent{event.key.code});
     }
     else if (event.type == sf::Event::MouseButtonPressed)
     {
-        auto it = m_mouseBindings.find(event.mouseButton.button);
-        if (it != m_mouseBindings.end())
-        {
-            m_mousePosition.x = event.mouseButton.x;
-            m_mousePosition.y = event.mouseButton.y;
-            for (const auto& callback : it->second)
-            {
-                callback(event.mouseButton.x, event.mouseButton.y);
-            }
-        }
+        m_mousePosition.x = event.mouseButton.x;
+        m_mousePosition.y = event.mouseButton.y;
+        m_events.publish(MouseButtonPressedEvent{event.mouseButton.button, event.mouseButton.x, event.mouseButton.y});
     }
     else if (event.type == sf::Event::MouseMoved)
     {
@@ -39,28 +25,7 @@ void InputManager::processEvent(const sf::Event& event)
     }
 }
 
-void InputManager::bindKey(sf::Keyboard::Key key, KeyCallback callback)
-{
-    m_keyBindings[key].push_back(callback);
-}
-
-void InputManager::unbindKey(sf::Keyboard::Key key)
-{
-    m_keyBindings.erase(key);
-}
-
-void InputManager::bindMouseButton(sf::Mouse::Button button, MouseCallback callback)
-{
-    m_mouseBindings[button].push_back(callback);
-}
-
-void InputManager::unbindMouseButton(sf::Mouse::Button button)
-{
-    m_mouseBindings.erase(button);
-}
-
 bool InputManager::isKeyPressed(sf::Keyboard::Key key) const
 {
     return sf::Keyboard::isKeyPressed(key);
 }
-
@@ -0,0 +1,43 @@
+#include "InputQueue.hpp"
+#include <algorithm>
+#include <chrono>
+
+std::int64_t InputQueue::now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+void InputQueue::push(const InputEvent& event)
+{
+    if (!m_events.push(event))
+    {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+SimulationInput InputQueue::drain(std::int64_t timeMicroseconds)
+{
+    SimulationInput input;
+    for (const InputEvent* event = m_events.peek(); event && event->timeMicroseconds <= timeMicroseconds;
+         event = m_events.peek())
+    {
+        switch (event->type)
+        {
+        case InputEvent::PaddleMove:
+            m_paddleTargetX = event->x;
+            break;
+        case InputEvent::Launch:
+            input.launch = true;
+            break;
+        case InputEvent::MultiBall:
+            input.multiBall = std::max(input.multiBall, event->count);
+            break;
+        }
+        m_events.pop();
+    }
+
+    input.paddleTargetX = m_paddleTargetX;
+    return input;
+}
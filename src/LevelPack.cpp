@@ -0,0 +1,355 @@
+#include "LevelPack.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+constexpr char MAGIC[4] = {'C', 'B', 'L', 'V'};
+constexpr std::uint16_t VERSION{1};
+constexpr std::size_t HEADER_SIZE{16};
+constexpr std::size_t ENTRY_SIZE{24};
+
+constexpr float DEFAULT_BRICK_WIDTH{70.f};
+constexpr float DEFAULT_BRICK_HEIGHT{30.f};
+constexpr float DEFAULT_SPACING{5.f};
+constexpr float DEFAULT_TOP{50.f};
+
+std::uint16_t readU16(const std::uint8_t* in)
+{
+    return static_cast<std::uint16_t>(in[0] | (in[1] << 8));
+}
+
+std::uint32_t readU32(const std::uint8_t* in)
+{
+    return static_cast<std::uint32_t>(in[0]) | (static_cast<std::uint32_t>(in[1]) << 8) |
+           (static_cast<std::uint32_t>(in[2]) << 16) | (static_cast<std::uint32_t>(in[3]) << 24);
+}
+
+float readF32(const std::uint8_t* in)
+{
+    std::uint32_t bits = readU32(in);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+void writeU16(std::vector<std::uint8_t>& out, std::size_t at, std::uint16_t value)
+{
+    out[at] = static_cast<std::uint8_t>(value);
+    out[at + 1] = static_cast<std::uint8_t>(value >> 8);
+}
+
+void writeU32(std::vector<std::uint8_t>& out, std::size_t at, std::uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        out[at + i] = static_cast<std::uint8_t>(value >> (i * 8));
+    }
+}
+
+void writeF32(std::vector<std::uint8_t>& out, std::size_t at, float value)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeU32(out, at, bits);
+}
+
+struct TextLevel
+{
+    float brickWidth{DEFAULT_BRICK_WIDTH};
+    float brickHeight{DEFAULT_BRICK_HEIGHT};
+    float spacing{DEFAULT_SPACING};
+    float top{DEFAULT_TOP};
+    std::vector<std::string> rows;
+};
+} // namespace
+
+void LevelView::appendBricks(BrickField& bricks, float playfieldWidth) const
+{
+    float pitchX = brickWidth + spacing;
+    float pitchY = brickHeight + spacing;
+    float startX = (playfieldWidth - (cols * pitchX - spacing)) / 2.f;
+
+    for (int row = 0; row < rows; ++row)
+    {
+        for (int col = 0; col < cols; ++col)
+        {
+            int health = getHealth(col, row);
+            if (health > 0)
+            {
+                bricks.add(startX + col * pitchX, top + row * pitchY, brickWidth, brickHeight, health);
+            }
+        }
+    }
+}
+
+LevelPack::~LevelPack()
+{
+    close();
+}
+
+bool LevelPack::open(const std::string& path)
+{
+    close();
+
+#if defined(_WIN32)
+    // No mapping on Windows yet: read the whole file once
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+    m_buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    std::size_t size = static_cast<std::size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps the file alive
+    if (mapping == MAP_FAILED)
+    {
+        return false;
+    }
+
+    m_mapping = mapping;
+    m_mappingSize = size;
+    m_data = static_cast<const std::uint8_t*>(mapping);
+    m_size = size;
+#endif
+
+    if (!validate())
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool LevelPack::openFromMemory(const std::uint8_t* data, std::size_t size)
+{
+    close();
+    m_data = data;
+    m_size = size;
+    if (!validate())
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void LevelPack::close()
+{
+#if !defined(_WIN32)
+    if (m_mapping != nullptr)
+    {
+        ::munmap(m_mapping, m_mappingSize);
+    }
+#endif
+    m_mapping = nullptr;
+    m_mappingSize = 0;
+    m_buffer.clear();
+    m_data = nullptr;
+    m_size = 0;
+    m_levelCount = 0;
+}
+
+LevelView LevelPack::getLevel(std::size_t index) const
+{
+    const std::uint8_t* entry = m_data + HEADER_SIZE + index * ENTRY_SIZE;
+
+    LevelView level;
+    level.cols = readU16(entry + 4);
+    level.rows = readU16(entry + 6);
+    level.brickWidth = readF32(entry + 8);
+    level.brickHeight = readF32(entry + 12);
+    level.spacing = readF32(entry + 16);
+    level.top = readF32(entry + 20);
+    level.cells = m_data + readU32(entry);
+    return level;
+}
+
+bool LevelPack::validate()
+{
+    if (m_size < HEADER_SIZE || std::memcmp(m_data, MAGIC, sizeof(MAGIC)) != 0 || readU16(m_data + 4) != VERSION)
+    {
+        return false;
+    }
+
+    std::size_t count = readU32(m_data + 8);
+    if (count > (m_size - HEADER_SIZE) / ENTRY_SIZE)
+    {
+        return false;
+    }
+
+    // Every level's cells must lie inside the file
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const std::uint8_t* entry = m_data + HEADER_SIZE + i * ENTRY_SIZE;
+        std::size_t offset = readU32(entry);
+        std::size_t cells = static_cast<std::size_t>(readU16(entry + 4)) * readU16(entry + 6);
+        if (offset < HEADER_SIZE + count * ENTRY_SIZE || offset > m_size || cells > m_size - offset)
+        {
+            return false;
+        }
+    }
+
+    m_levelCount = count;
+    return true;
+}
+
+bool compileLevelText(std::istream& input, std::vector<std::uint8_t>& pack, std::string& error)
+{
+    std::vector<TextLevel> levels;
+    bool inLevel = false;
+    std::string line;
+
+    for (int lineNumber = 1; std::getline(input, line); ++lineNumber)
+    {
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+
+        auto fail = [&](const std::string& message)
+        {
+            error = "line " + std::to_string(lineNumber) + ": " + message;
+            return false;
+        };
+
+        std::istringstream words(line);
+        std::string keyword;
+        words >> keyword;
+
+        if (!inLevel)
+        {
+            if (keyword.empty() || keyword[0] == '#')
+            {
+                continue;
+            }
+            if (keyword != "level")
+            {
+                return fail("expected 'level'");
+            }
+            levels.emplace_back();
+            inLevel = true;
+            continue;
+        }
+
+        TextLevel& level = levels.back();
+        if (keyword == "end")
+        {
+            if (level.rows.empty())
+            {
+                return fail("level has no rows");
+            }
+            inLevel = false;
+        }
+        else if (keyword == "brick")
+        {
+            if (!(words >> level.brickWidth >> level.brickHeight) || level.brickWidth <= 0.f || level.brickHeight <= 0.f)
+            {
+                return fail("expected 'brick <width> <height>'");
+            }
+        }
+        else if (keyword == "spacing")
+        {
+            if (!(words >> level.spacing) || level.spacing < 0.f)
+            {
+                return fail("expected 'spacing <pixels>'");
+            }
+        }
+        else if (keyword == "top")
+        {
+            if (!(words >> level.top))
+            {
+                return fail("expected 'top <y>'");
+            }
+        }
+        else if (!keyword.empty() && keyword[0] == '#')
+        {
+            continue;
+        }
+        else
+        {
+            if (line.find_first_not_of(" .123456789") != std::string::npos)
+            {
+                return fail("rows may only contain '1'-'9', '.' and spaces");
+            }
+            if (level.rows.size() == 0xFFFF || line.size() > 0xFFFF)
+            {
+                return fail("level is larger than 65535 cells on a side");
+            }
+            level.rows.push_back(line);
+        }
+    }
+
+    if (inLevel)
+    {
+        error = "missing 'end' after the last level";
+        return false;
+    }
+
+    // Header and entry table, then every level's cells
+    std::size_t tableEnd = HEADER_SIZE + levels.size() * ENTRY_SIZE;
+    pack.assign(tableEnd, 0);
+    std::memcpy(pack.data(), MAGIC, sizeof(MAGIC));
+    writeU16(pack, 4, VERSION);
+    writeU32(pack, 8, static_cast<std::uint32_t>(levels.size()));
+
+    for (std::size_t i = 0; i < levels.size(); ++i)
+    {
+        const TextLevel& level = levels[i];
+        std::size_t cols = 0;
+        for (const std::string& row : level.rows)
+        {
+            cols = std::max(cols, row.size());
+        }
+
+        std::size_t entry = HEADER_SIZE + i * ENTRY_SIZE;
+        writeU32(pack, entry, static_cast<std::uint32_t>(pack.size()));
+        writeU16(pack, entry + 4, static_cast<std::uint16_t>(cols));
+        writeU16(pack, entry + 6, static_cast<std::uint16_t>(level.rows.size()));
+        writeF32(pack, entry + 8, level.brickWidth);
+        writeF32(pack, entry + 12, level.brickHeight);
+        writeF32(pack, entry + 16, level.spacing);
+        writeF32(pack, entry + 20, level.top);
+
+        for (const std::string& row : level.rows)
+        {
+            for (std::size_t col = 0; col < cols; ++col)
+            {
+                char c = col < row.size() ? row[col] : '.';
+                std::uint8_t health = (c >= '1' && c <= '9') ? static_cast<std::uint8_t>(c - '0') : 0;
+                pack.push_back(static_cast<std::uint8_t>(static_cast<std::uint8_t>(BrickType::Standard) << 4) | health);
+            }
+        }
+    }
+    return true;
+}
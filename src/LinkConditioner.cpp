@@ -0,0 +1,83 @@
+#include "LinkConditioner.hpp"
+#include <cstring>
+
+void LinkConditioner::setConditions(const Conditions& conditions)
+{
+    m_conditions = conditions;
+    m_random.seed(conditions.seed);
+}
+
+bool LinkConditioner::push(const unsigned char* data, std::size_t size, std::int64_t nowMicroseconds)
+{
+    ++m_stats.pushed;
+
+    // Drawn for every datagram, so a seed gives the same losses and delays
+    // whatever happens to the queue
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    double loss = unit(m_random);
+    double jitter = unit(m_random);
+    if (loss < m_conditions.lossRate)
+    {
+        ++m_stats.lost;
+        return false;
+    }
+    if (size > MAX_DATAGRAM_SIZE || m_count == CAPACITY)
+    {
+        ++m_stats.overflowed;
+        return false;
+    }
+
+    Datagram& datagram = m_datagrams[m_count++];
+    double delay = m_conditions.latencyMilliseconds + jitter * m_conditions.jitterMilliseconds;
+    datagram.dueMicroseconds = nowMicroseconds + static_cast<std::int64_t>(delay * 1000.0);
+    datagram.sequence = m_nextSequence++;
+    datagram.size = size;
+    std::memcpy(datagram.bytes.data(), data, size);
+    return true;
+}
+
+bool LinkConditioner::pop(std::int64_t nowMicroseconds, unsigned char* out, std::size_t capacity, std::size_t& size)
+{
+    while (true)
+    {
+        // A linear scan: the queue holds a few dozen datagrams at most in practice
+        std::size_t next = m_count;
+        for (std::size_t i = 0; i < m_count; ++i)
+        {
+            const Datagram& datagram = m_datagrams[i];
+            if (datagram.dueMicroseconds <= nowMicroseconds &&
+                (next == m_count || datagram.dueMicroseconds < m_datagrams[next].dueMicroseconds ||
+                 (datagram.dueMicroseconds == m_datagrams[next].dueMicroseconds &&
+                  datagram.sequence < m_datagrams[next].sequence)))
+            {
+                next = i;
+            }
+        }
+        if (next == m_count)
+        {
+            return false;
+        }
+
+        bool fits = m_datagrams[next].size <= capacity;
+        if (fits)
+        {
+            size = m_datagrams[next].size;
+            std::memcpy(out, m_datagrams[next].bytes.data(), size);
+            ++m_stats.delivered;
+        }
+        else
+        {
+            ++m_stats.overflowed;
+        }
+        if (next != m_count - 1)
+        {
+            m_datagrams[next] = m_datagrams[m_count - 1];
+        }
+        --m_count;
+
+        if (fits)
+        {
+            return true;
+        }
+    }
+}
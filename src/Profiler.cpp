@@ -0,0 +1,117 @@
+#include "Profiler.hpp"
+
+#ifdef CASSEBRIQUES_PROFILING
+
+#include <algorithm>
+#include <fstream>
+
+Profiler::Profiler()
+    : m_history(HISTORY_FRAMES)
+{
+}
+
+Profiler& Profiler::getInstance()
+{
+    static Profiler instance;
+    return instance;
+}
+
+const char* Profiler::getSectionName(ProfileSection section)
+{
+    switch (section)
+    {
+    case ProfileSection::Frame:
+        return "frame";
+    case ProfileSection::Events:
+        return "events";
+    case ProfileSection::Simulation:
+        return "simulation";
+    case ProfileSection::Paddle:
+        return "paddle";
+    case ProfileSection::BallPhysics:
+        return "ball_physics";
+    case ProfileSection::BrickCollision:
+        return "brick_collision";
+    case ProfileSection::Cleanup:
+        return "cleanup";
+    case ProfileSection::Render:
+        return "render";
+    case ProfileSection::Count:
+        break;
+    }
+    return "?";
+}
+
+void Profiler::endFrame()
+{
+    FrameSample sample;
+    bool timed = false;
+    for (std::size_t i = 0; i < SECTION_COUNT; ++i)
+    {
+        std::int64_t total = m_current[i].exchange(0, std::memory_order_relaxed);
+        sample[i] = static_cast<float>(total) / 1000.f;
+        timed = timed || total != 0;
+    }
+    if (!timed)
+    {
+        return;
+    }
+    m_history[m_frameCount % HISTORY_FRAMES] = sample;
+    ++m_frameCount;
+}
+
+Profiler::Stats Profiler::getStats(ProfileSection section) const
+{
+    Stats stats;
+    std::size_t count = std::min(m_frameCount, WINDOW_FRAMES);
+    if (count == 0)
+    {
+        return stats;
+    }
+
+    std::array<float, WINDOW_FRAMES> values;
+    std::size_t column = static_cast<std::size_t>(section);
+    float sum = 0.f;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        values[i] = getRecentFrame(i)[column];
+        sum += values[i];
+    }
+
+    std::size_t p99 = (count * 99) / 100;
+    std::nth_element(values.begin(), values.begin() + p99, values.begin() + count);
+    stats.p99Microseconds = values[p99];
+    stats.minMicroseconds = *std::min_element(values.begin(), values.begin() + count);
+    stats.avgMicroseconds = sum / static_cast<float>(count);
+    return stats;
+}
+
+bool Profiler::writeCsv(const std::string& path) const
+{
+    std::ofstream file(path);
+    if (!file)
+    {
+        return false;
+    }
+
+    file << "frame";
+    for (std::size_t i = 0; i < SECTION_COUNT; ++i)
+    {
+        file << ',' << getSectionName(static_cast<ProfileSection>(i)) << "_us";
+    }
+    file << '\n';
+
+    std::size_t kept = std::min(m_frameCount, HISTORY_FRAMES);
+    for (std::size_t frame = m_frameCount - kept; frame < m_frameCount; ++frame)
+    {
+        file << frame;
+        for (float value : m_history[frame % HISTORY_FRAMES])
+        {
+            file << ',' << value;
+        }
+        file << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+#endif
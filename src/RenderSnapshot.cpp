@@ -0,0 +1,33 @@
+#include "RenderSnapshot.hpp"
+
+void RenderSnapshot::capture(const Simulation& simulation, std::int64_t tickEnd)
+{
+    state = simulation.getState();
+    lives = simulation.getLives();
+    score = simulation.getScore();
+    tick = simulation.getTick();
+    tickEndMicroseconds = tickEnd;
+
+    previousPaddlePosition = simulation.getPreviousPaddlePosition();
+    paddlePosition = simulation.getPaddle().getPosition();
+    paddleSize = simulation.getPaddle().getSize();
+    balls = simulation.getBalls(); // Fits the reserved capacity, so no reallocation
+    bricks.syncFrom(simulation.getBricks());
+}
+
+void SnapshotBuffer::publish()
+{
+    // Release: the snapshot's contents become visible with its index
+    std::uint8_t previous = m_ready.exchange(static_cast<std::uint8_t>(m_write | FRESH), std::memory_order_acq_rel);
+    m_write = static_cast<std::uint8_t>(previous & ~FRESH);
+}
+
+const RenderSnapshot& SnapshotBuffer::acquire()
+{
+    if (m_ready.load(std::memory_order_relaxed) & FRESH)
+    {
+        std::uint8_t ready = m_ready.exchange(m_read, std::memory_order_acq_rel);
+        m_read = static_cast<std::uint8_t>(ready & ~FRESH);
+    }
+    return m_buffers[m_read];
+}
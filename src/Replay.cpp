@@ -0,0 +1,185 @@
+#include "Replay.hpp"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+constexpr char MAGIC[4] = {'C', 'B', 'R', 'P'};
+constexpr std::uint16_t VERSION{1};
+constexpr std::size_t HEADER_SIZE{16};
+constexpr std::size_t RUN_SIZE{7};
+
+void writeU16(std::vector<std::uint8_t>& out, std::uint16_t value)
+{
+    out.push_back(static_cast<std::uint8_t>(value));
+    out.push_back(static_cast<std::uint8_t>(value >> 8));
+}
+
+void writeU32(std::vector<std::uint8_t>& out, std::uint32_t value)
+{
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        out.push_back(static_cast<std::uint8_t>(value >> shift));
+    }
+}
+
+void writeF32(std::vector<std::uint8_t>& out, float value)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeU32(out, bits);
+}
+
+std::uint16_t readU16(const std::uint8_t* in)
+{
+    return static_cast<std::uint16_t>(in[0] | (in[1] << 8));
+}
+
+std::uint32_t readU32(const std::uint8_t* in)
+{
+    return static_cast<std::uint32_t>(in[0]) | (static_cast<std::uint32_t>(in[1]) << 8) |
+           (static_cast<std::uint32_t>(in[2]) << 16) | (static_cast<std::uint32_t>(in[3]) << 24);
+}
+
+float readF32(const std::uint8_t* in)
+{
+    std::uint32_t bits = readU32(in);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+std::uint8_t packFlags(const SimulationInput& input)
+{
+    int extras = input.multiBall < 0 ? 0 : (input.multiBall > 127 ? 127 : input.multiBall);
+    return static_cast<std::uint8_t>((input.launch ? 1 : 0) | (extras << 1));
+}
+} // namespace
+
+ReplayRecorder::ReplayRecorder()
+    : m_tickCount(0)
+    , m_ballSpeedMultiplier(1.f)
+{
+}
+
+void ReplayRecorder::clear()
+{
+    m_runs.clear();
+    m_tickCount = 0;
+}
+
+void ReplayRecorder::record(const SimulationInput& input)
+{
+    std::uint8_t flags = packFlags(input);
+    ++m_tickCount;
+
+    // Extend the current run when the input is bit-identical to the previous tick
+    if (!m_runs.empty())
+    {
+        Run& last = m_runs.back();
+        if (last.repeat < 0xFFFF && last.flags == flags &&
+            std::memcmp(&last.paddleTargetX, &input.paddleTargetX, sizeof(float)) == 0)
+        {
+            ++last.repeat;
+            return;
+        }
+    }
+
+    m_runs.push_back(Run{1, input.paddleTargetX, flags});
+}
+
+std::vector<std::uint8_t> ReplayRecorder::toBytes() const
+{
+    std::vector<std::uint8_t> bytes;
+    bytes.reserve(HEADER_SIZE + m_runs.size() * RUN_SIZE);
+
+    for (char c : MAGIC)
+    {
+        bytes.push_back(static_cast<std::uint8_t>(c));
+    }
+    writeU16(bytes, VERSION);
+    writeU16(bytes, static_cast<std::uint16_t>(Simulation::STEPS_PER_SECOND));
+    writeF32(bytes, m_ballSpeedMultiplier);
+    writeU32(bytes, static_cast<std::uint32_t>(m_tickCount));
+
+    for (const auto& run : m_runs)
+    {
+        writeU16(bytes, run.repeat);
+        writeF32(bytes, run.paddleTargetX);
+        bytes.push_back(run.flags);
+    }
+    return bytes;
+}
+
+bool ReplayRecorder::saveToFile(const std::string& path) const
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    std::vector<std::uint8_t> bytes = toBytes();
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(file);
+}
+
+bool ReplayPlayer::loadFromFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return loadFromMemory(bytes.data(), bytes.size());
+}
+
+bool ReplayPlayer::loadFromMemory(const std::uint8_t* data, std::size_t size)
+{
+    if (size < HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0 ||
+        readU16(data + 4) != VERSION || (size - HEADER_SIZE) % RUN_SIZE != 0)
+    {
+        return false;
+    }
+
+    m_stepsPerSecond = readU16(data + 6);
+    m_ballSpeedMultiplier = readF32(data + 8);
+    m_tickCount = readU32(data + 12);
+    m_data.assign(data, data + size);
+    m_cursor = HEADER_SIZE;
+    m_runRemaining = 0;
+    return true;
+}
+
+void ReplayPlayer::begin(Simulation& simulation)
+{
+    m_cursor = HEADER_SIZE;
+    m_runRemaining = 0;
+    simulation.setBallSpeedMultiplier(m_ballSpeedMultiplier);
+    simulation.startGame();
+}
+
+bool ReplayPlayer::next(SimulationInput& input)
+{
+    while (m_runRemaining == 0)
+    {
+        if (m_cursor + RUN_SIZE > m_data.size())
+        {
+            return false;
+        }
+
+        const std::uint8_t* run = m_data.data() + m_cursor;
+        m_runRemaining = readU16(run);
+        m_runInput.paddleTargetX = readF32(run + 2);
+        m_runInput.launch = (run[6] & 1) != 0;
+        m_runInput.multiBall = run[6] >> 1;
+        m_cursor += RUN_SIZE;
+    }
+
+    --m_runRemaining;
+    input = m_runInput;
+    return true;
+}
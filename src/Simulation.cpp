@@ -0,0 +1,702 @@
+#include "Simulation.hpp"
+#include "Collision.hpp"
+#include "CollisionBatch.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+// Gap left between the ball and a surface after a contact
+constexpr float CONTACT_SKIN{0.01f};
+
+// Destroyed bricks below this count are never worth a grid compaction
+constexpr std::size_t MIN_COMPACTED_BRICKS{64};
+
+// Bricks of the default wall against the ball, for the compile-time collision kernel
+struct ClassicBrick
+{
+    static constexpr float WIDTH{Simulation::BRICK_WIDTH};
+    static constexpr float HEIGHT{Simulation::BRICK_HEIGHT};
+    static constexpr float RADIUS{Simulation::BALL_RADIUS};
+};
+using ClassicBrickShape = collision::FixedBoxShape<ClassicBrick>;
+
+// Fixed part of a SimulationSnapshot, at the start of its buffer; the ball
+// columns follow
+struct SavedState
+{
+    Simulation::GameState state;
+    int lives;
+    int score;
+    bool ballLaunched;
+    std::uint64_t tick;
+    sf::Vector2f paddlePosition;
+    sf::Vector2f previousPaddlePosition;
+    float ballSpeedMultiplier;
+    float paddleDeflectionDegrees;
+    int paddleBounces;
+    std::uint32_t brickGeneration; // Game the snapshot belongs to
+    std::size_t brickCount;
+    std::size_t brickChanges; // Brick change log position
+    std::uint64_t gridBuilds;
+    std::size_t ballCount;
+};
+
+// Earliest contact of a moving circle with the left, right and top walls
+bool sweepWalls(const sf::Vector2f& center, const sf::Vector2f& displacement, float radius,
+                float width, collision::SweepHit& hit)
+{
+    bool found = false;
+    auto consider = [&](float time, const sf::Vector2f& normal)
+    {
+        time = std::max(0.f, time);
+        if (time <= 1.f && (!found || time < hit.time))
+        {
+            hit.time = time;
+            hit.normal = normal;
+            hit.startedInside = false;
+            found = true;
+        }
+    };
+
+    if (displacement.x < 0.f && center.x + displacement.x < radius)
+    {
+        consider((radius - center.x) / displacement.x, sf::Vector2f(1.f, 0.f));
+    }
+    if (displacement.x > 0.f && center.x + displacement.x > width - radius)
+    {
+        consider((width - radius - center.x) / displacement.x, sf::Vector2f(-1.f, 0.f));
+    }
+    if (displacement.y < 0.f && center.y + displacement.y < radius)
+    {
+        consider((radius - center.y) / displacement.y, sf::Vector2f(0.f, 1.f));
+    }
+    return found;
+}
+} // namespace
+
+Simulation::Simulation()
+    : m_state(MENU)
+    , m_lives(INITIAL_LIVES)
+    , m_score(0)
+    , m_balls(BALL_RADIUS)
+    , m_brickGrid(sf::Vector2f(BRICK_WIDTH + BRICK_SPACING, BRICK_HEIGHT + BRICK_SPACING))
+    , m_bricksInGrid(0)
+    , m_gridBuilds(0)
+    , m_brickSizes(BrickSizes::Classic)
+    , m_brickSize(BRICK_WIDTH, BRICK_HEIGHT)
+    , m_ballLaunched(false)
+    , m_tick(0)
+    , m_ballSpeedMultiplier(1.f)
+    , m_paddleDeflectionDegrees(PADDLE_DEFLECTION_DEGREES)
+    , m_paddleBounces(0)
+{
+    float paddleX = WINDOW_WIDTH / 2.f - PADDLE_WIDTH / 2.f;
+    float paddleY = WINDOW_HEIGHT - PADDLE_HEIGHT - 20.f;
+    m_paddle = std::make_unique<Paddle>(paddleX, paddleY, PADDLE_WIDTH, PADDLE_HEIGHT);
+    m_previousPaddlePosition = m_paddle->getPosition();
+    m_balls.reserve(MAX_BALLS);
+    m_events.subscribe<BrickDestroyedEvent, &Simulation::scoreBrick>(*this);
+}
+
+void Simulation::startGame()
+{
+    resetGame();
+    createBricks();
+    rebuildBrickGrid();
+    resetBall();
+}
+
+void Simulation::startGame(const BrickField& layout)
+{
+    resetGame();
+    m_bricks.reserve(layout.size());
+    for (std::size_t i = 0; i < layout.size(); ++i)
+    {
+        sf::FloatRect aabb = layout.getAABB(i);
+        m_bricks.add(aabb.left, aabb.top, aabb.width, aabb.height, layout.getMaxHealth(i));
+    }
+    rebuildBrickGrid();
+    resetBall();
+}
+
+void Simulation::startGame(const LevelView& level)
+{
+    resetGame();
+    m_bricks.reserve(static_cast<std::size_t>(level.cols) * level.rows);
+    level.appendBricks(m_bricks, static_cast<float>(WINDOW_WIDTH));
+    rebuildBrickGrid();
+    resetBall();
+}
+
+void Simulation::resetGame()
+{
+    m_state = PLAYING;
+    m_lives = INITIAL_LIVES;
+    m_score = 0;
+    m_ballLaunched = false;
+    m_tick = 0;
+    m_paddleBounces = 0;
+
+    // Every game starts from the same paddle position so replays are reproducible
+    m_paddle->setPosition(WINDOW_WIDTH / 2.f - PADDLE_WIDTH / 2.f, m_paddle->getPosition().y);
+    m_previousPaddlePosition = m_paddle->getPosition();
+
+    m_bricks.clear();
+    m_events.clear();
+}
+
+void Simulation::returnToMenu()
+{
+    m_state = MENU;
+}
+
+void Simulation::step(const SimulationInput& input)
+{
+    if (m_state != PLAYING)
+    {
+        return;
+    }
+
+    CB_PROFILE_SCOPE(Simulation);
+    const float deltaTime = STEP_SECONDS;
+    ++m_tick;
+    storePreviousPositions();
+
+    if (input.launch)
+    {
+        launchBall();
+    }
+
+    if (input.multiBall > 0)
+    {
+        spawnMultiBall(input.multiBall);
+    }
+
+    updatePaddle(input.paddleTargetX, deltaTime);
+    updateBalls(deltaTime);
+    compactBrickGrid();
+    checkVictory();
+    m_events.dispatch();
+}
+
+void Simulation::createBricks()
+{
+    float brickStartX = (WINDOW_WIDTH - (BRICK_COLS * (BRICK_WIDTH + BRICK_SPACING) - BRICK_SPACING)) / 2.f;
+    float brickStartY = 50.f;
+
+    m_bricks.reserve(static_cast<std::size_t>(BRICK_ROWS) * BRICK_COLS);
+
+    for (int row = 0; row < BRICK_ROWS; ++row)
+    {
+        for (int col = 0; col < BRICK_COLS; ++col)
+        {
+            float x = brickStartX + col * (BRICK_WIDTH + BRICK_SPACING);
+            float y = brickStartY + row * (BRICK_HEIGHT + BRICK_SPACING);
+            int health = BRICK_ROWS - row;
+            m_bricks.add(x, y, BRICK_WIDTH, BRICK_HEIGHT, health);
+        }
+    }
+}
+
+void Simulation::rebuildBrickGrid()
+{
+    // Cells match the brick pitch so each brick sits in a single cell
+    sf::Vector2f largest(BRICK_WIDTH, BRICK_HEIGHT);
+    m_brickBoxes.clear();
+    for (std::size_t i = 0; i < m_bricks.size(); ++i)
+    {
+        m_brickBoxes.push_back(m_bricks.getAABB(i));
+        largest.x = i == 0 ? m_brickBoxes[i].width : std::max(largest.x, m_brickBoxes[i].width);
+        largest.y = i == 0 ? m_brickBoxes[i].height : std::max(largest.y, m_brickBoxes[i].height);
+    }
+    m_brickGrid.setCellSize(largest + sf::Vector2f(BRICK_SPACING, BRICK_SPACING));
+    m_brickGrid.build(m_brickBoxes);
+    m_bricksInGrid = m_bricks.countAlive();
+    ++m_gridBuilds;
+
+    // Same size everywhere lets the collision kernel skip the per-brick dimensions
+    bool uniform = std::all_of(m_brickBoxes.begin(), m_brickBoxes.end(), [this](const sf::FloatRect& box)
+    {
+        return box.width == m_brickBoxes[0].width && box.height == m_brickBoxes[0].height;
+    });
+    m_brickSize = m_brickBoxes.empty() ? sf::Vector2f(BRICK_WIDTH, BRICK_HEIGHT)
+                                       : sf::Vector2f(m_brickBoxes[0].width, m_brickBoxes[0].height);
+    if (!uniform)
+    {
+        m_brickSizes = BrickSizes::Mixed;
+    }
+    else if (m_brickSize == sf::Vector2f(BRICK_WIDTH, BRICK_HEIGHT))
+    {
+        m_brickSizes = BrickSizes::Classic;
+    }
+    else
+    {
+        m_brickSizes = BrickSizes::Uniform;
+    }
+
+    // Every hit appends to the brick change log: size it for the whole level now
+    m_bricks.reserveChangeLog();
+}
+
+void Simulation::compactBrickGrid()
+{
+    // Queries skip destroyed bricks, so they only leave the grid once they
+    // outnumber the live ones: each compaction is paid for by as many deaths
+    // as it removes, and queries on a nearly cleared level stay short
+    std::size_t alive = m_bricks.countAlive();
+    std::size_t dead = m_bricksInGrid - alive;
+    if (dead < MIN_COMPACTED_BRICKS || dead <= alive)
+    {
+        return;
+    }
+
+    CB_PROFILE_SCOPE(Cleanup);
+    m_brickGrid.compact([this](std::uint32_t id) { return m_bricks.isAlive(id); });
+    m_bricksInGrid = alive;
+    ++m_gridBuilds;
+}
+
+void Simulation::spawnMultiBall(int extraPerBall)
+{
+    if (m_state != PLAYING || !m_ballLaunched || extraPerBall <= 0)
+    {
+        return;
+    }
+
+    std::size_t existing = m_balls.size();
+    for (std::size_t i = 0; i < existing && m_balls.size() < MAX_BALLS; ++i)
+    {
+        sf::Vector2f position = m_balls.getPosition(i);
+        sf::Vector2f velocity = m_balls.getVelocity(i);
+        bool gravityEnabled = m_balls.isGravityEnabled(i);
+
+        // Alternate sides: +1, -1, +2, -2... spread steps around the original direction
+        for (int k = 0; k < extraPerBall && m_balls.size() < MAX_BALLS; ++k)
+        {
+            float side = (k % 2 == 0) ? 1.f : -1.f;
+            float angle = side * static_cast<float>(k / 2 + 1) * MULTIBALL_SPREAD_DEGREES * 3.14159265f / 180.f;
+            float c = std::cos(angle);
+            float s = std::sin(angle);
+            sf::Vector2f rotated(velocity.x * c - velocity.y * s, velocity.x * s + velocity.y * c);
+            m_balls.spawn(position, rotated, gravityEnabled);
+        }
+    }
+}
+
+void Simulation::resetBall()
+{
+    m_balls.clear();
+    m_balls.spawn(restingBallPosition(), sf::Vector2f(0.f, 0.f), false);
+    m_ballLaunched = false;
+}
+
+void Simulation::launchBall()
+{
+    if (m_ballLaunched || m_balls.empty())
+    {
+        return;
+    }
+
+    m_balls.setPosition(0, restingBallPosition());
+    m_balls.setVelocity(0, sf::Vector2f(0.f, -BALL_SPEED * m_ballSpeedMultiplier));
+    m_balls.setGravityEnabled(0, true);
+    m_ballLaunched = true;
+}
+
+sf::Vector2f Simulation::restingBallPosition() const
+{
+    float ballX = m_paddle->getPosition().x + PADDLE_WIDTH / 2.f - BALL_RADIUS;
+    float ballY = m_paddle->getPosition().y - BALL_RADIUS * 2.f;
+    return sf::Vector2f(ballX, ballY);
+}
+
+void Simulation::updatePaddle(float targetX, float deltaTime)
+{
+    CB_PROFILE_SCOPE(Paddle);
+    float paddleX = targetX - PADDLE_WIDTH / 2.f;
+    paddleX = std::max(0.f, std::min(paddleX, static_cast<float>(WINDOW_WIDTH) - PADDLE_WIDTH));
+    m_paddle->setPosition(paddleX, WINDOW_HEIGHT - PADDLE_HEIGHT - 20.f);
+    m_paddle->update(deltaTime);
+}
+
+void Simulation::storePreviousPositions()
+{
+    m_previousPaddlePosition = m_paddle->getPosition();
+    m_balls.storePreviousPositions();
+}
+
+void Simulation::updateBalls(float deltaTime)
+{
+    if (m_balls.empty())
+    {
+        return;
+    }
+
+    if (!m_ballLaunched)
+    {
+        // Ball rests on the paddle until launched
+        m_balls.setPosition(0, restingBallPosition());
+        m_balls.setVelocity(0, sf::Vector2f(0.f, 0.f));
+        m_balls.setGravityEnabled(0, false);
+        return;
+    }
+
+    {
+        CB_PROFILE_SCOPE(BallPhysics);
+        for (std::size_t i = 0; i < m_balls.size();)
+        {
+            if (updateBall(i, deltaTime))
+            {
+                ++i;
+            }
+            else
+            {
+                // Fell below the screen; the last ball moves into this slot
+                m_balls.remove(i);
+            }
+        }
+    }
+
+    checkGameOver();
+}
+
+bool Simulation::updateBall(std::size_t index, float deltaTime)
+{
+    sf::Vector2f center = m_balls.getPosition(index) + sf::Vector2f(BALL_RADIUS, BALL_RADIUS);
+    sf::Vector2f velocity = m_balls.getVelocity(index);
+
+    if (m_balls.isGravityEnabled(index))
+    {
+        velocity.y += BALL_GRAVITY * deltaTime;
+    }
+
+    // Move contact by contact through the step so fast balls bounce instead of tunnelling
+    float remaining = deltaTime;
+    for (int bounce = 0; bounce < MAX_BOUNCES_PER_STEP && remaining > 0.f; ++bounce)
+    {
+        sf::Vector2f displacement = velocity * remaining;
+
+        Contact contact;
+        auto consider = [&contact](ContactTarget target, const collision::SweepHit& hit, std::uint32_t brick)
+        {
+            if (contact.target == ContactTarget::None || hit.time < contact.hit.time)
+            {
+                contact.target = target;
+                contact.hit = hit;
+                contact.brick = brick;
+            }
+        };
+
+        collision::SweepHit hit;
+        if (sweepWalls(center, displacement, BALL_RADIUS, static_cast<float>(WINDOW_WIDTH), hit))
+        {
+            consider(ContactTarget::Wall, hit, 0);
+        }
+        if (collision::sweepCircleAABB(center, displacement, BALL_RADIUS, m_paddle->getBounds(), hit))
+        {
+            consider(ContactTarget::Paddle, hit, 0);
+        }
+
+        // Bricks: only the grid cells under the swept circle are tested
+        sf::Vector2f end = center + displacement;
+        float sweepLeft = std::min(center.x, end.x) - BALL_RADIUS;
+        float sweepTop = std::min(center.y, end.y) - BALL_RADIUS;
+        float sweepRight = std::max(center.x, end.x) + BALL_RADIUS;
+        float sweepBottom = std::max(center.y, end.y) + BALL_RADIUS;
+        sf::FloatRect sweep(sweepLeft, sweepTop, sweepRight - sweepLeft, sweepBottom - sweepTop);
+
+        {
+            CB_PROFILE_SCOPE(BrickCollision);
+            const float* brickX = m_bricks.xData();
+            const float* brickY = m_bricks.yData();
+            auto queryBricks = [&](auto shapeOf)
+            {
+                // Candidates go through the SIMD kernel eight at a time, the rest
+                // (all of them on sparse levels) through the scalar one. Both give
+                // the same contacts, and batches keep the query order, so the
+                // earliest contact is the one a box-by-box loop would pick.
+                collision::BoxBatch candidates;
+                std::uint32_t ids[collision::SWEEP_BATCH];
+                m_brickGrid.query(sweep, [&](std::uint32_t id)
+                {
+                    if (!m_bricks.isAlive(id))
+                    {
+                        return;
+                    }
+                    auto shape = shapeOf(id);
+                    ids[candidates.count] = id;
+                    candidates.push(brickX[id], brickY[id], shape.width(), shape.height());
+                    if (candidates.full())
+                    {
+                        collision::SweepBatchHit batchHit;
+                        if (collision::sweepCircleBoxes(center, displacement, BALL_RADIUS, candidates, batchHit))
+                        {
+                            consider(ContactTarget::Brick, batchHit.hit, ids[batchHit.earliest]);
+                        }
+                        candidates.clear();
+                    }
+                });
+
+                for (std::size_t i = 0; i < candidates.count; ++i)
+                {
+                    collision::SweepHit brickHit;
+                    if (collision::sweepCircleBox(shapeOf(ids[i]), center, displacement, candidates.left[i],
+                                                  candidates.top[i], brickHit))
+                    {
+                        consider(ContactTarget::Brick, brickHit, ids[i]);
+                    }
+                }
+            };
+
+            switch (m_brickSizes)
+            {
+            case BrickSizes::Classic:
+                queryBricks([](std::uint32_t) { return ClassicBrickShape(); });
+                break;
+
+            case BrickSizes::Uniform:
+            {
+                collision::BoxShape uniform{m_brickSize.x, m_brickSize.y, BALL_RADIUS};
+                queryBricks([uniform](std::uint32_t) { return uniform; });
+                break;
+            }
+
+            case BrickSizes::Mixed:
+            {
+                const float* width = m_bricks.widthData();
+                const float* height = m_bricks.heightData();
+                queryBricks([width, height](std::uint32_t id)
+                {
+                    return collision::BoxShape{width[id], height[id], BALL_RADIUS};
+                });
+                break;
+            }
+            }
+        }
+
+        if (contact.target == ContactTarget::None)
+        {
+            center = end;
+            break;
+        }
+
+        // Stop just short of the surface so the next sweep starts outside of it
+        float time = contact.hit.time;
+        float length = std::sqrt(displacement.x * displacement.x + displacement.y * displacement.y);
+        if (length > 0.f)
+        {
+            time = std::max(0.f, time - CONTACT_SKIN / length);
+        }
+        center += displacement * time;
+        remaining -= remaining * contact.hit.time;
+
+        switch (contact.target)
+        {
+        case ContactTarget::Wall:
+            velocity = collision::reflect(velocity, contact.hit.normal);
+            break;
+
+        case ContactTarget::Paddle:
+            if (contact.hit.normal.y < 0.f)
+            {
+                velocity = deflectOffPaddle(center, velocity);
+                ++m_paddleBounces;
+                if (contact.hit.startedInside)
+                {
+                    // The paddle moved onto the ball: lift the ball back on top
+                    center.y = m_paddle->getPosition().y - BALL_RADIUS - CONTACT_SKIN;
+                }
+            }
+            else
+            {
+                velocity = collision::reflect(velocity, contact.hit.normal);
+            }
+            break;
+
+        case ContactTarget::Brick:
+            if (contact.hit.startedInside)
+            {
+                sf::Vector2f position = center - sf::Vector2f(BALL_RADIUS, BALL_RADIUS);
+                collision::resolveCircleAABB(position, velocity, BALL_RADIUS, m_bricks.getAABB(contact.brick));
+                center = position + sf::Vector2f(BALL_RADIUS, BALL_RADIUS);
+            }
+            else
+            {
+                velocity = collision::reflect(velocity, contact.hit.normal);
+            }
+            if (m_bricks.takeDamage(contact.brick, 1))
+            {
+                m_events.publish(BrickDestroyedEvent{contact.brick, BRICK_POINTS});
+            }
+            break;
+
+        case ContactTarget::None:
+            break;
+        }
+    }
+
+    m_balls.setPosition(index, center - sf::Vector2f(BALL_RADIUS, BALL_RADIUS));
+    m_balls.setVelocity(index, velocity);
+
+    return center.y + BALL_RADIUS <= static_cast<float>(WINDOW_HEIGHT);
+}
+
+sf::Vector2f Simulation::deflectOffPaddle(const sf::Vector2f& ballCenter, const sf::Vector2f& velocity) const
+{
+    // Deflect up to m_paddleDeflectionDegrees depending on the hit position
+    float paddleCenterX = m_paddle->getPosition().x + PADDLE_WIDTH / 2.f;
+    float hitPosition = (ballCenter.x - paddleCenterX) / (PADDLE_WIDTH / 2.f);
+    hitPosition = std::max(-1.f, std::min(1.f, hitPosition));
+
+    float angle = hitPosition * m_paddleDeflectionDegrees * 3.14159265f / 180.f;
+    float speed = std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y);
+    float launchSpeed = BALL_SPEED * m_ballSpeedMultiplier;
+    if (speed < launchSpeed * 0.5f)
+    {
+        speed = launchSpeed;
+    }
+
+    return sf::Vector2f(std::sin(angle) * speed, -std::abs(std::cos(angle) * speed));
+}
+
+void Simulation::checkGameOver()
+{
+    // A life is only lost once the last ball has left the screen
+    if (!m_balls.empty())
+    {
+        return;
+    }
+
+    m_lives--;
+    m_events.publish(LifeLostEvent{m_lives});
+    if (m_lives <= 0)
+    {
+        m_state = GAME_OVER;
+    }
+    else
+    {
+        resetBall();
+    }
+}
+
+void Simulation::scoreBrick(const BrickDestroyedEvent& event)
+{
+    m_score += event.points;
+    m_events.publish(ScoreChangedEvent{m_score, event.points});
+}
+
+void Simulation::checkVictory()
+{
+    if (!m_bricks.empty() && m_bricks.allDestroyed())
+    {
+        m_state = VICTORY;
+    }
+}
+
+std::uint64_t Simulation::computeStateHash() const
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, std::size_t size)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    auto mixValue = [&mix](const auto& value) { mix(&value, sizeof(value)); };
+
+    mixValue(static_cast<int>(m_state));
+    mixValue(m_lives);
+    mixValue(m_score);
+    mixValue(m_ballLaunched);
+    mixValue(m_tick);
+    mixValue(m_paddle->getPosition().x);
+    mixValue(m_paddle->getPosition().y);
+
+    for (std::size_t i = 0; i < m_balls.size(); ++i)
+    {
+        mixValue(m_balls.getPosition(i).x);
+        mixValue(m_balls.getPosition(i).y);
+        mixValue(m_balls.getVelocity(i).x);
+        mixValue(m_balls.getVelocity(i).y);
+        mixValue(m_balls.isGravityEnabled(i));
+    }
+
+    mix(m_bricks.healthData(), m_bricks.size() * sizeof(std::int32_t));
+    mix(m_bricks.aliveData(), m_bricks.aliveWordCount() * sizeof(std::uint64_t));
+    return hash;
+}
+
+void Simulation::saveState(SimulationSnapshot& snapshot) const
+{
+    SavedState saved;
+    saved.state = m_state;
+    saved.lives = m_lives;
+    saved.score = m_score;
+    saved.ballLaunched = m_ballLaunched;
+    saved.tick = m_tick;
+    saved.paddlePosition = m_paddle->getPosition();
+    saved.previousPaddlePosition = m_previousPaddlePosition;
+    saved.ballSpeedMultiplier = m_ballSpeedMultiplier;
+    saved.paddleDeflectionDegrees = m_paddleDeflectionDegrees;
+    saved.paddleBounces = m_paddleBounces;
+    saved.brickGeneration = m_bricks.getGeneration();
+    saved.brickCount = m_bricks.size();
+    saved.brickChanges = m_bricks.getChangeLog().size();
+    saved.gridBuilds = m_gridBuilds;
+    saved.ballCount = m_balls.size();
+
+    if (snapshot.m_bytes.empty())
+    {
+        snapshot.m_bytes.reserve(sizeof(SavedState) + MAX_BALLS * BallField::BYTES_PER_BALL);
+    }
+    snapshot.m_bytes.resize(sizeof(SavedState) + m_balls.getStateSize());
+    std::memcpy(snapshot.m_bytes.data(), &saved, sizeof(SavedState));
+    m_balls.saveState(snapshot.m_bytes.data() + sizeof(SavedState));
+    snapshot.m_tick = m_tick;
+}
+
+bool Simulation::restoreState(const SimulationSnapshot& snapshot)
+{
+    if (!snapshot.isValid())
+    {
+        return false;
+    }
+
+    SavedState saved;
+    std::memcpy(&saved, snapshot.m_bytes.data(), sizeof(SavedState));
+    if (saved.brickGeneration != m_bricks.getGeneration() || saved.brickCount != m_bricks.size() ||
+        saved.brickChanges > m_bricks.getChangeLog().size())
+    {
+        return false;
+    }
+
+    m_state = saved.state;
+    m_lives = saved.lives;
+    m_score = saved.score;
+    m_ballLaunched = saved.ballLaunched;
+    m_tick = saved.tick;
+    m_paddle->setPosition(saved.paddlePosition);
+    m_previousPaddlePosition = saved.previousPaddlePosition;
+    m_ballSpeedMultiplier = saved.ballSpeedMultiplier;
+    m_paddleDeflectionDegrees = saved.paddleDeflectionDegrees;
+    m_paddleBounces = saved.paddleBounces;
+    m_balls.restoreState(snapshot.m_bytes.data() + sizeof(SavedState), saved.ballCount);
+    m_events.clear();
+
+    // Bricks compacted out of the grid since the save may be alive again: put
+    // them all back (queries skip dead bricks and keep their order either way)
+    bool revived = m_bricks.rewindTo(saved.brickChanges);
+    if (revived && m_gridBuilds != saved.gridBuilds)
+    {
+        m_brickGrid.build(m_brickBoxes);
+        m_bricksInGrid = m_bricks.countAlive();
+        ++m_gridBuilds;
+    }
+    return true;
+}
@@ -0,0 +1,106 @@
+#include "SimulationThread.hpp"
+#include "InputQueue.hpp"
+#include <chrono>
+#include <utility>
+
+SimulationThread::SimulationThread(Simulation& simulation, StepFunction step)
+    : m_simulation(simulation)
+    , m_step(std::move(step))
+    , m_timestep(Simulation::STEP_SECONDS, Simulation::MAX_STEPS_PER_FRAME)
+{
+}
+
+SimulationThread::~SimulationThread()
+{
+    stop();
+}
+
+void SimulationThread::start()
+{
+    if (m_running.exchange(true))
+    {
+        return;
+    }
+    m_thread = std::thread(&SimulationThread::run, this);
+}
+
+void SimulationThread::stop()
+{
+    m_running.store(false);
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+void SimulationThread::post(std::function<void()> command)
+{
+    ++m_commandsPosted;
+    std::lock_guard<std::mutex> lock(m_commandMutex);
+    m_commands.push_back(std::move(command));
+    m_hasCommands.store(true, std::memory_order_release);
+}
+
+bool SimulationThread::runCommands()
+{
+    if (!m_hasCommands.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_commandMutex);
+        m_runningCommands.swap(m_commands);
+        m_hasCommands.store(false, std::memory_order_relaxed);
+    }
+    for (auto& command : m_runningCommands)
+    {
+        command();
+    }
+    m_commandsRun += m_runningCommands.size();
+    m_runningCommands.clear();
+    return true;
+}
+
+void SimulationThread::publish(std::int64_t tickEndMicroseconds)
+{
+    RenderSnapshot& snapshot = m_snapshots.beginWrite();
+    snapshot.capture(m_simulation, tickEndMicroseconds);
+    snapshot.commandsRun = m_commandsRun;
+    m_snapshots.publish();
+}
+
+void SimulationThread::run()
+{
+    std::int64_t last = InputQueue::now();
+    std::int64_t lastTickEnd = last;
+    publish(lastTickEnd);
+
+    double stepMicroseconds = m_timestep.getStepSeconds() * 1e6;
+    while (m_running.load())
+    {
+        // Shown at once, even if no step is due yet (menus do not step)
+        if (runCommands())
+        {
+            publish(lastTickEnd);
+        }
+
+        // Same accounting as a frame loop: simulated time trails the clock by
+        // the accumulator, so step i of this batch ends (steps - 1 - i + alpha)
+        // steps before now
+        std::int64_t now = InputQueue::now();
+        int steps = m_timestep.advance(static_cast<double>(now - last) / 1e6);
+        last = now;
+        for (int i = 0; i < steps; ++i)
+        {
+            double stepsAgo = steps - 1 - i + m_timestep.getAlpha();
+            lastTickEnd = now - static_cast<std::int64_t>(stepsAgo * stepMicroseconds);
+            m_step(lastTickEnd);
+            publish(lastTickEnd);
+        }
+
+        // Sleep until the next step is due
+        double untilNextStep = (1.0 - m_timestep.getAlpha()) * stepMicroseconds;
+        std::this_thread::sleep_for(std::chrono::microseconds(static_cast<std::int64_t>(untilNextStep) + 1));
+    }
+}
@@ -0,0 +1,97 @@
+#include "SpatialGrid.hpp"
+#include <limits>
+
+SpatialGrid::SpatialGrid(const sf::Vector2f& cellSize)
+    : m_cellSize(cellSize)
+    , m_origin(0.f, 0.f)
+{
+}
+
+void SpatialGrid::clear()
+{
+    m_cols = 0;
+    m_rows = 0;
+    m_cellStart.clear();
+    m_items.clear();
+    m_itemMinCell.clear();
+}
+
+void SpatialGrid::build(const std::vector<sf::FloatRect>& boxes)
+{
+    clear();
+    if (boxes.empty())
+    {
+        return;
+    }
+
+    // Fit the grid to the bounds of all boxes
+    float minX = std::numeric_limits<float>::max();
+    float minY = std::numeric_limits<float>::max();
+    float maxX = std::numeric_limits<float>::lowest();
+    float maxY = std::numeric_limits<float>::lowest();
+    for (const auto& box : boxes)
+    {
+        minX = std::min(minX, box.left);
+        minY = std::min(minY, box.top);
+        maxX = std::max(maxX, box.left + box.width);
+        maxY = std::max(maxY, box.top + box.height);
+    }
+
+    m_origin = sf::Vector2f(minX, minY);
+    m_cols = std::max(1, static_cast<int>(std::ceil((maxX - minX) / m_cellSize.x)));
+    m_rows = std::max(1, static_cast<int>(std::ceil((maxY - minY) / m_cellSize.y)));
+
+    std::size_t cellCount = static_cast<std::size_t>(m_cols) * m_rows;
+    m_cellStart.assign(cellCount + 1, 0);
+    m_itemMinCell.resize(boxes.size());
+
+    // Counting pass: number of ids per cell
+    for (std::size_t id = 0; id < boxes.size(); ++id)
+    {
+        CellRange range = cellRange(boxes[id]);
+        m_itemMinCell[id] = static_cast<std::uint32_t>(range.y0 * m_cols + range.x0);
+        for (int cy = range.y0; cy <= range.y1; ++cy)
+        {
+            for (int cx = range.x0; cx <= range.x1; ++cx)
+            {
+                ++m_cellStart[static_cast<std::size_t>(cy) * m_cols + cx + 1];
+            }
+        }
+    }
+
+    for (std::size_t cell = 0; cell < cellCount; ++cell)
+    {
+        m_cellStart[cell + 1] += m_cellStart[cell];
+    }
+
+    // Fill pass: ids keep their relative order inside each cell
+    m_items.resize(m_cellStart[cellCount]);
+    m_cursor.assign(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (std::size_t id = 0; id < boxes.size(); ++id)
+    {
+        CellRange range = cellRange(boxes[id]);
+        for (int cy = range.y0; cy <= range.y1; ++cy)
+        {
+            for (int cx = range.x0; cx <= range.x1; ++cx)
+            {
+                m_items[m_cursor[static_cast<std::size_t>(cy) * m_cols + cx]++] = static_cast<std::uint32_t>(id);
+            }
+        }
+    }
+}
+
+SpatialGrid::CellRange SpatialGrid::cellRange(const sf::FloatRect& area) const
+{
+    auto toCell = [](float offset, float cellSize, int count)
+    {
+        int cell = static_cast<int>(std::floor(offset / cellSize));
+        return std::max(0, std::min(cell, count - 1));
+    };
+
+    CellRange range;
+    range.x0 = toCell(area.left - m_origin.x, m_cellSize.x, m_cols);
+    range.y0 = toCell(area.top - m_origin.y, m_cellSize.y, m_rows);
+    range.x1 = toCell(area.left + area.width - m_origin.x, m_cellSize.x, m_cols);
+    range.y1 = toCell(area.top + area.height - m_origin.y, m_cellSize.y, m_rows);
+    return range;
+}
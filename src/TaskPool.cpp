@@ -0,0 +1,114 @@
+#include "TaskPool.hpp"
+#include <algorithm>
+
+TaskPool::TaskPool(unsigned int threadCount)
+{
+    if (threadCount == 0)
+    {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // All deques exist before any worker may try to steal from them
+    for (unsigned int i = 0; i < threadCount; ++i)
+    {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+    for (std::size_t i = 0; i < m_workers.size(); ++i)
+    {
+        m_workers[i]->thread = std::thread(&TaskPool::run, this, i);
+    }
+}
+
+TaskPool::~TaskPool()
+{
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    for (auto& worker : m_workers)
+    {
+        worker->thread.join();
+    }
+}
+
+void TaskPool::submit(std::function<void()> task)
+{
+    m_unfinished.fetch_add(1);
+
+    // Counted under the sleep lock so a worker about to sleep cannot miss it,
+    // and before the push so a thief never takes the count below zero
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_queued.fetch_add(1);
+    }
+
+    Worker& worker = *m_workers[m_nextWorker.fetch_add(1) % m_workers.size()];
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    }
+    m_wake.notify_one();
+}
+
+void TaskPool::wait()
+{
+    std::unique_lock<std::mutex> lock(m_sleepMutex);
+    m_idle.wait(lock, [this]() { return m_unfinished.load() == 0; });
+}
+
+bool TaskPool::takeTask(std::size_t self, std::function<void()>& task)
+{
+    // Own deque first, newest task (still warm in cache)
+    {
+        Worker& own = *m_workers[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty())
+        {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    // Then the oldest task of the next worker that has any
+    for (std::size_t offset = 1; offset < m_workers.size(); ++offset)
+    {
+        Worker& victim = *m_workers[(self + offset) % m_workers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskPool::run(std::size_t self)
+{
+    for (;;)
+    {
+        std::function<void()> task;
+        if (takeTask(self, task))
+        {
+            m_queued.fetch_sub(1);
+            task();
+            if (m_unfinished.fetch_sub(1) == 1)
+            {
+                std::lock_guard<std::mutex> lock(m_sleepMutex);
+                m_idle.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wake.wait(lock, [this]() { return m_stopping || m_queued.load() > 0; });
+        if (m_stopping && m_queued.load() == 0)
+        {
+            return;
+        }
+    }
+}
@@ -0,0 +1,175 @@
+#include "TextureAtlas.hpp"
+#include <algorithm>
+#include <numeric>
+
+namespace
+{
+// Sprites are drawn at a few dozen pixels; the source PNGs are far larger
+const sf::Vector2u BALL_SIZE(32, 32);
+const sf::Vector2u PADDLE_SIZE(128, 32);
+const sf::Vector2u BRICK_SIZE(128, 64);
+const sf::Vector2u WHITE_SIZE(4, 4);
+
+// Lay the rects out in shelves no wider than `width`, in the given order
+sf::Vector2u packShelves(const std::vector<sf::Vector2u>& sizes, const std::vector<std::size_t>& order,
+                         unsigned int width, unsigned int padding, std::vector<sf::IntRect>& rects)
+{
+    unsigned int x = 0;
+    unsigned int y = 0;
+    unsigned int shelfHeight = 0;
+    unsigned int usedWidth = 0;
+    for (std::size_t index : order)
+    {
+        const sf::Vector2u& size = sizes[index];
+        if (x > 0 && x + size.x > width)
+        {
+            y += shelfHeight + padding;
+            x = 0;
+            shelfHeight = 0;
+        }
+        rects[index] = sf::IntRect(static_cast<int>(x), static_cast<int>(y), static_cast<int>(size.x),
+                                   static_cast<int>(size.y));
+        usedWidth = std::max(usedWidth, x + size.x);
+        shelfHeight = std::max(shelfHeight, size.y);
+        x += size.x + padding;
+    }
+    return sf::Vector2u(usedWidth, y + shelfHeight);
+}
+
+// Source texels covered by target texel `i` of `count` (at least one)
+void sourceSpan(unsigned int i, unsigned int count, unsigned int sourceCount, unsigned int& first, unsigned int& last)
+{
+    first = i * sourceCount / count;
+    last = std::max(first + 1, (i + 1) * sourceCount / count);
+}
+
+// Box-filtered downscale (or nearest upscale) of a whole image into `rect`
+void blitScaled(const sf::Image& source, sf::Image& target, const sf::IntRect& rect, const sf::Color& tint)
+{
+    sf::Vector2u sourceSize = source.getSize();
+    unsigned int width = static_cast<unsigned int>(rect.width);
+    unsigned int height = static_cast<unsigned int>(rect.height);
+    for (unsigned int y = 0; y < height; ++y)
+    {
+        unsigned int y0, y1;
+        sourceSpan(y, height, sourceSize.y, y0, y1);
+        for (unsigned int x = 0; x < width; ++x)
+        {
+            unsigned int x0, x1;
+            sourceSpan(x, width, sourceSize.x, x0, x1);
+
+            unsigned int sum[4] = {0, 0, 0, 0};
+            for (unsigned int sy = y0; sy < y1; ++sy)
+            {
+                for (unsigned int sx = x0; sx < x1; ++sx)
+                {
+                    sf::Color c = source.getPixel(sx, sy);
+                    sum[0] += c.r;
+                    sum[1] += c.g;
+                    sum[2] += c.b;
+                    sum[3] += c.a;
+                }
+            }
+            unsigned int count = (y1 - y0) * (x1 - x0);
+            sf::Color average(static_cast<sf::Uint8>(sum[0] / count), static_cast<sf::Uint8>(sum[1] / count),
+                              static_cast<sf::Uint8>(sum[2] / count), static_cast<sf::Uint8>(sum[3] / count));
+            target.setPixel(static_cast<unsigned int>(rect.left) + x, static_cast<unsigned int>(rect.top) + y,
+                            average * tint);
+        }
+    }
+}
+} // namespace
+
+float AtlasPacking::getDensity() const
+{
+    if (size.x == 0 || size.y == 0)
+    {
+        return 0.f;
+    }
+
+    float used = 0.f;
+    for (const sf::IntRect& rect : rects)
+    {
+        used += static_cast<float>(rect.width) * static_cast<float>(rect.height);
+    }
+    return used / (static_cast<float>(size.x) * static_cast<float>(size.y));
+}
+
+AtlasPacking packAtlas(const std::vector<sf::Vector2u>& sizes, unsigned int padding)
+{
+    AtlasPacking packing;
+    packing.rects.resize(sizes.size());
+    if (sizes.empty())
+    {
+        return packing;
+    }
+
+    // Tallest first keeps shelves full
+    std::vector<std::size_t> order(sizes.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&sizes](std::size_t a, std::size_t b)
+    {
+        return sizes[a].y != sizes[b].y ? sizes[a].y > sizes[b].y : sizes[a].x > sizes[b].x;
+    });
+
+    unsigned int widest = 0;
+    unsigned int singleRow = 0;
+    for (const sf::Vector2u& size : sizes)
+    {
+        widest = std::max(widest, size.x);
+        singleRow += size.x + padding;
+    }
+
+    // Try every strip width between the widest rect and one single shelf
+    std::vector<sf::IntRect> rects(sizes.size());
+    unsigned long bestArea = 0;
+    for (unsigned int width = widest; width <= singleRow; ++width)
+    {
+        sf::Vector2u size = packShelves(sizes, order, width, padding, rects);
+        unsigned long area = static_cast<unsigned long>(size.x) * size.y;
+        if (bestArea == 0 || area < bestArea)
+        {
+            bestArea = area;
+            packing.size = size;
+            packing.rects = rects;
+        }
+    }
+    return packing;
+}
+
+bool TextureAtlas::build(const sf::Image& ball, const sf::Image& brick, const sf::Image& paddle)
+{
+    for (const sf::Image* source : {&ball, &brick, &paddle})
+    {
+        if (source->getSize().x == 0 || source->getSize().y == 0)
+        {
+            return false;
+        }
+    }
+
+    // Indexed by AtlasSprite
+    std::vector<sf::Vector2u> sizes = {WHITE_SIZE, BALL_SIZE, PADDLE_SIZE, BRICK_SIZE, BRICK_SIZE, BRICK_SIZE};
+    AtlasPacking packing = packAtlas(sizes, PADDING);
+    std::copy(packing.rects.begin(), packing.rects.end(), m_rects.begin());
+    m_density = packing.getDensity();
+
+    m_image.create(packing.size.x, packing.size.y, sf::Color::Transparent);
+    blitScaled(ball, m_image, getRect(AtlasSprite::Ball), sf::Color::White);
+    blitScaled(paddle, m_image, getRect(AtlasSprite::Paddle), sf::Color::White);
+    for (int state = 0; state < Brick::HEALTH_STATE_COUNT; ++state)
+    {
+        Brick::HealthState healthState = static_cast<Brick::HealthState>(state);
+        blitScaled(brick, m_image, getRect(brickSprite(healthState)), Brick::colorForState(healthState));
+    }
+
+    const sf::IntRect& white = getRect(AtlasSprite::White);
+    for (int y = 0; y < white.height; ++y)
+    {
+        for (int x = 0; x < white.width; ++x)
+        {
+            m_image.setPixel(static_cast<unsigned int>(white.left + x), static_cast<unsigned int>(white.top + y),
+                             sf::Color::White);
+        }
+    }
+    return true;
+}
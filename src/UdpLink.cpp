@@ -0,0 +1,61 @@
+#include "UdpLink.hpp"
+#include "InputQueue.hpp"
+#include <array>
+
+bool UdpLink::open(unsigned short localPort, const sf::IpAddress& peer, unsigned short peerPort)
+{
+    close();
+    if (m_socket.bind(localPort) != sf::Socket::Done)
+    {
+        return false;
+    }
+    m_socket.setBlocking(false);
+    m_peer = peer;
+    m_peerPort = peerPort;
+    return true;
+}
+
+void UdpLink::close()
+{
+    m_socket.unbind();
+}
+
+void UdpLink::send(const unsigned char* data, std::size_t size)
+{
+    m_conditioner.push(data, size, InputQueue::now());
+}
+
+void UdpLink::update()
+{
+    std::array<unsigned char, LinkConditioner::MAX_DATAGRAM_SIZE> buffer;
+    std::size_t size = 0;
+    std::int64_t now = InputQueue::now();
+    while (m_conditioner.pop(now, buffer.data(), buffer.size(), size))
+    {
+        // A datagram the socket refuses is lost like any other
+        if (m_socket.send(buffer.data(), size, m_peer, m_peerPort) == sf::Socket::Done)
+        {
+            ++m_stats.sent;
+        }
+        else
+        {
+            ++m_stats.errors;
+        }
+    }
+}
+
+bool UdpLink::receive(unsigned char* out, std::size_t capacity, std::size_t& size)
+{
+    sf::IpAddress sender;
+    unsigned short senderPort = 0;
+    while (m_socket.receive(out, capacity, size, sender, senderPort) == sf::Socket::Done)
+    {
+        if (sender == m_peer && senderPort == m_peerPort)
+        {
+            ++m_stats.received;
+            return true;
+        }
+        ++m_stats.ignored;
+    }
+    return false;
+}
@@ -0,0 +1,289 @@
+#include "VersusSession.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace
+{
+constexpr std::uint32_t PACKET_MAGIC{0x53564243}; // "CBVS"
+
+// Packets are read back by the same build on the same kind of machine, so
+// fields are copied in native byte order
+template <typename T>
+unsigned char* writeField(unsigned char* out, T value)
+{
+    std::memcpy(out, &value, sizeof(T));
+    return out + sizeof(T);
+}
+
+template <typename T>
+const unsigned char* readField(const unsigned char* in, T& value)
+{
+    std::memcpy(&value, in, sizeof(T));
+    return in + sizeof(T);
+}
+
+bool sameInput(const SimulationInput& a, const SimulationInput& b)
+{
+    // Bitwise on the paddle target: any difference changes the simulation
+    return std::memcmp(&a.paddleTargetX, &b.paddleTargetX, sizeof(float)) == 0 && a.launch == b.launch &&
+           a.multiBall == b.multiBall;
+}
+} // namespace
+
+VersusSession::VersusSession(Simulation& player0, Simulation& player1, int localPlayer)
+    : m_players{&player0, &player1}
+    , m_localPlayer(localPlayer)
+{
+}
+
+void VersusSession::start()
+{
+    for (Simulation* player : m_players)
+    {
+        player->startGame();
+    }
+    reset();
+}
+
+void VersusSession::start(const BrickField& layout)
+{
+    for (Simulation* player : m_players)
+    {
+        player->startGame(layout);
+    }
+    reset();
+}
+
+void VersusSession::start(const LevelView& level)
+{
+    for (Simulation* player : m_players)
+    {
+        player->startGame(level);
+    }
+    reset();
+}
+
+void VersusSession::reset()
+{
+    m_tick = 0;
+    m_steppedTick = 0;
+    m_confirmedTick = 0;
+    m_remoteAck = 0;
+    m_rollbackFrom = 0;
+    m_remoteInputTicks.fill(0);
+    m_stats = Stats();
+}
+
+bool VersusSession::canAdvance() const
+{
+    // The remote side may be ahead: its inputs can be confirmed past m_tick
+    return m_tick < m_confirmedTick + MAX_ROLLBACK && m_tick < m_remoteAck + INPUT_HISTORY;
+}
+
+void VersusSession::advance(const SimulationInput& localInput)
+{
+    if (m_rollbackFrom != 0)
+    {
+        rollBack();
+    }
+
+    ++m_tick;
+    ++m_stats.ticks;
+    m_localInputs[m_tick % INPUT_HISTORY] = localInput;
+    simulate(m_tick);
+}
+
+void VersusSession::settle()
+{
+    if (m_rollbackFrom != 0)
+    {
+        rollBack();
+    }
+}
+
+bool VersusSession::isSettled() const
+{
+    // Ticks after the end of the match changed nothing, whatever they predicted
+    return m_rollbackFrom == 0 && m_confirmedTick >= m_steppedTick;
+}
+
+bool VersusSession::isFinished() const
+{
+    Simulation::GameState first = m_players[0]->getState();
+    Simulation::GameState second = m_players[1]->getState();
+    return first == Simulation::VICTORY || second == Simulation::VICTORY ||
+           (first != Simulation::PLAYING && second != Simulation::PLAYING);
+}
+
+int VersusSession::getWinner() const
+{
+    if (!isFinished())
+    {
+        return -1;
+    }
+
+    // Both clearing the level on the same tick comes down to the score too
+    bool firstCleared = m_players[0]->getState() == Simulation::VICTORY;
+    bool secondCleared = m_players[1]->getState() == Simulation::VICTORY;
+    if (firstCleared != secondCleared)
+    {
+        return firstCleared ? 0 : 1;
+    }
+    int firstScore = m_players[0]->getScore();
+    int secondScore = m_players[1]->getScore();
+    return firstScore == secondScore ? -1 : (firstScore > secondScore ? 0 : 1);
+}
+
+SimulationInput VersusSession::remoteInputFor(std::uint64_t tick) const
+{
+    if (tick <= m_confirmedTick)
+    {
+        return m_remoteInputs[tick % INPUT_HISTORY];
+    }
+
+    // The paddle most likely stays where it was heading; one-shot actions are
+    // never guessed, they only show up once they really happened
+    SimulationInput predicted;
+    predicted.paddleTargetX = Simulation::WINDOW_WIDTH / 2.f;
+    if (m_confirmedTick > 0)
+    {
+        predicted.paddleTargetX = m_remoteInputs[m_confirmedTick % INPUT_HISTORY].paddleTargetX;
+    }
+    return predicted;
+}
+
+void VersusSession::simulate(std::uint64_t tick)
+{
+    for (int player = 0; player < 2; ++player)
+    {
+        m_players[player]->saveState(m_snapshots[player][(tick - 1) % SNAPSHOTS]);
+    }
+
+    SimulationInput remote = remoteInputFor(tick);
+    m_usedRemoteInputs[tick % INPUT_HISTORY] = remote;
+    if (isFinished())
+    {
+        return;
+    }
+    m_players[m_localPlayer]->step(m_localInputs[tick % INPUT_HISTORY]);
+    m_players[1 - m_localPlayer]->step(remote);
+    m_steppedTick = tick;
+}
+
+void VersusSession::rollBack()
+{
+    auto start = std::chrono::steady_clock::now();
+
+    // canAdvance() keeps the first mispredicted tick within reach of the snapshots
+    std::uint64_t first = m_rollbackFrom;
+    for (int player = 0; player < 2; ++player)
+    {
+        m_players[player]->restoreState(m_snapshots[player][(first - 1) % SNAPSHOTS]);
+    }
+    m_steppedTick = std::min(m_steppedTick, first - 1);
+    for (std::uint64_t tick = first; tick <= m_tick; ++tick)
+    {
+        simulate(tick);
+    }
+    m_rollbackFrom = 0;
+
+    std::size_t depth = static_cast<std::size_t>(m_tick - first + 1);
+    double microseconds =
+        std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    ++m_stats.rollbacks;
+    ++m_stats.rollbackDepths[std::min(depth, MAX_ROLLBACK)];
+    m_stats.resimulatedTicks += depth;
+    m_stats.maxRollbackDepth = std::max(m_stats.maxRollbackDepth, depth);
+    m_stats.lastResimulationMicroseconds = microseconds;
+    m_stats.maxResimulationMicroseconds = std::max(m_stats.maxResimulationMicroseconds, microseconds);
+    m_stats.totalResimulationMicroseconds += microseconds;
+}
+
+std::size_t VersusSession::writePacket(unsigned char* out, std::size_t capacity) const
+{
+    if (capacity < MAX_PACKET_SIZE)
+    {
+        return 0;
+    }
+
+    // Oldest unacknowledged input first, so the peer can confirm without gaps
+    std::uint64_t first = m_remoteAck + 1;
+    std::uint64_t last = std::min(m_tick, first + MAX_PACKET_INPUTS - 1);
+    std::uint8_t count = static_cast<std::uint8_t>(last >= first ? last - first + 1 : 0);
+
+    unsigned char* cursor = writeField(out, PACKET_MAGIC);
+    cursor = writeField(cursor, static_cast<std::uint32_t>(m_confirmedTick));
+    cursor = writeField(cursor, static_cast<std::uint32_t>(first));
+    cursor = writeField(cursor, count);
+    for (std::uint64_t tick = first; tick < first + count; ++tick)
+    {
+        const SimulationInput& input = m_localInputs[tick % INPUT_HISTORY];
+        cursor = writeField(cursor, input.paddleTargetX);
+        cursor = writeField(cursor, static_cast<std::uint8_t>(input.launch ? 1 : 0));
+        cursor = writeField(cursor, static_cast<std::uint8_t>(std::min(std::max(input.multiBall, 0), 255)));
+    }
+    return static_cast<std::size_t>(cursor - out);
+}
+
+bool VersusSession::readPacket(const unsigned char* data, std::size_t size)
+{
+    std::uint32_t magic = 0;
+    std::uint32_t ack = 0;
+    std::uint32_t first = 0;
+    std::uint8_t count = 0;
+    if (size >= PACKET_HEADER_SIZE)
+    {
+        data = readField(data, magic);
+        data = readField(data, ack);
+        data = readField(data, first);
+        data = readField(data, count);
+    }
+    if (magic != PACKET_MAGIC || first == 0 || size != PACKET_HEADER_SIZE + count * PACKET_INPUT_SIZE)
+    {
+        ++m_stats.packetsRejected;
+        return false;
+    }
+    ++m_stats.packetsRead;
+
+    m_remoteAck = std::max(m_remoteAck, std::min<std::uint64_t>(ack, m_tick));
+    for (std::uint64_t tick = first; tick < std::uint64_t{first} + count; ++tick)
+    {
+        SimulationInput input;
+        std::uint8_t launch = 0;
+        std::uint8_t multiBall = 0;
+        data = readField(data, input.paddleTargetX);
+        data = readField(data, launch);
+        data = readField(data, multiBall);
+        input.launch = launch != 0;
+        input.multiBall = multiBall;
+
+        // Already confirmed, or further ahead than the peer can be (it waits
+        // for our inputs too): keeping it could overwrite a slot still needed
+        if (tick <= m_confirmedTick || tick > m_tick + MAX_ROLLBACK)
+        {
+            continue;
+        }
+        m_remoteInputs[tick % INPUT_HISTORY] = input;
+        m_remoteInputTicks[tick % INPUT_HISTORY] = tick;
+    }
+
+    // Confirm up to the first gap; a tick that stepped the fields with
+    // something else rolls back at the next advance() or settle()
+    std::uint64_t next = m_confirmedTick + 1;
+    while (m_remoteInputTicks[next % INPUT_HISTORY] == next)
+    {
+        if (next <= m_steppedTick && m_rollbackFrom == 0 &&
+            !sameInput(m_remoteInputs[next % INPUT_HISTORY], m_usedRemoteInputs[next % INPUT_HISTORY]))
+        {
+            m_rollbackFrom = next;
+        }
+        m_confirmedTick = next++;
+    }
+    return true;
+}
+
+std::uint64_t VersusSession::computeStateHash() const
+{
+    return m_players[0]->computeStateHash() * 31 + m_players[1]->computeStateHash();
+}
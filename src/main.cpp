@@ -1,389 +1,529 @@
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdio>
 #include <iostream>
-#include <vector>
 #include <memory>
-#include <algorithm>
-#include <cmath>
+#include <string>
 
-#include "GameObject.hpp"
+#include "AssetLoader.hpp"
+#include "FrameRenderer.hpp"
 #include "InputManager.hpp"
-#include "Brick.hpp"
-#include "Paddle.hpp"
-#include "Ball.hpp"
-
+#include "InputQueue.hpp"
+#include "LevelPack.hpp"
+#include "Profiler.hpp"
+#include "Replay.hpp"
+#include "Simulation.hpp"
+#include "SimulationThread.hpp"
+#include "UdpLink.hpp"
+#include "VersusSession.hpp"
+
+// Window, font and rendering around the headless Simulation. The window thread
+// polls events and draws snapshots; the simulation steps on its own thread.
 class Game {
 public:
-    enum GameState { MENU, PLAYING, GAME_OVER, VICTORY };
-
     Game();
     int run();
 
+    // Record every game to this file (overwritten at each new game)
+    void recordTo(const std::string& path);
+    // Start straight into a recorded game; control returns to the mouse when it ends
+    bool playFrom(const std::string& path);
+    // Play the levels of a compiled pack in order instead of the default wall
+    bool loadLevels(const std::string& path);
+    // Race another player over UDP: each game is a versus match on the first
+    // level, against the CasseBriquesGame (or CasseBriquesVersus) at `peer`
+    bool playVersus(int side, const std::string& peer);
+
 private:
-    static constexpr unsigned int WINDOW_WIDTH{800u};
-    static constexpr unsigned int WINDOW_HEIGHT{600u};
-    static constexpr float BALL_RADIUS{8.f};
-    static constexpr float BALL_SPEED{400.f};
-    static constexpr float PADDLE_WIDTH{100.f};
-    static constexpr float PADDLE_HEIGHT{15.f};
-    static constexpr float BRICK_WIDTH{70.f};
-    static constexpr float BRICK_HEIGHT{30.f};
-    static constexpr float BRICK_SPACING{5.f};
-    static constexpr int BRICK_ROWS{5};
-    static constexpr int BRICK_COLS{10};
-    static constexpr int INITIAL_LIVES{3};
+    static constexpr unsigned int WINDOW_WIDTH{Simulation::WINDOW_WIDTH};
+    static constexpr unsigned int WINDOW_HEIGHT{Simulation::WINDOW_HEIGHT};
 
     sf::RenderWindow window;
-    sf::Clock clock;
-    sf::Font font;
-    GameState state;
-    int lives;
-    int score;
-
-    std::unique_ptr<Paddle> paddle;
-    std::unique_ptr<Ball> ball;
-    std::vector<std::unique_ptr<Brick>> bricks;
-    bool ballLaunched;
-
-    void initializeGame();
-    void createBricks();
-    void resetBall();
-    void handleEvents();
-    void update(float deltaTime);
-    void draw();
-    void checkGameOver();
-    void resetGameState();
+    Simulation simulation; // Only touched by the simulation thread while it runs
+    FrameRenderer frame;
+    InputQueue inputQueue; // Filled by handleEvents, drained by update at each tick
+
+    std::string recordPath;
+    ReplayRecorder recorder;
+    ReplayPlayer player;
+    bool replaying;
+
+    LevelPack levels;
+    std::size_t levelIndex;
+
+    // Versus mode: the opponent's field is stepped here too, but not drawn
+    Simulation opponent;
+    UdpLink link;
+    std::unique_ptr<VersusSession> versus;
+    bool versusPlaying; // Simulation thread only
+
+    // Declared after everything its steps and commands read, so it stops first
+    SimulationThread simulationThread;
+
+    // Declared after everything its jobs read, so it is destroyed (and joined) first
+    AssetLoader loader;
+    AssetHandle<sf::Font> font;
+    bool fontApplied;
+    AssetHandle<TextureAtlas> atlas;
+    sf::Texture atlasTexture;
+    AssetHandle<BrickField> nextLevel; // Bricks of levelIndex + 1, unpacked in the background
+
+#ifdef CASSEBRIQUES_PROFILING
+    bool showProfiler;
+    void onKeyPressed(const KeyPressedEvent& event);
+    void drawProfiler();
+#endif
+
+    void pollAssets();
+    void startGame();
+    void saveRecording();
+    void handleEvents(const RenderSnapshot& snapshot);
+    void update(std::int64_t tickEndMicroseconds);
+    void updateVersus(const SimulationInput& input);
+    void draw(const RenderSnapshot& snapshot, float alpha);
 };
 
 Game::Game()
     : window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "Casse Briques"),
-      state(MENU), lives(INITIAL_LIVES), score(0), ballLaunched(false)
+      replaying(false),
+      levelIndex(0),
+      versusPlaying(false),
+      simulationThread(simulation, [this](std::int64_t tickEnd) { update(tickEnd); }),
+      fontApplied(false)
+#ifdef CASSEBRIQUES_PROFILING
+      , showProfiler(false)
+#endif
 {
     window.setFramerateLimit(60);
-    
-    // Try to load a system font, but continue without it if unavailable
-    const std::string fontPaths[] = {
+#ifdef CASSEBRIQUES_PROFILING
+    InputManager::getInstance().getEvents().subscribe<KeyPressedEvent, &Game::onKeyPressed>(*this);
+#endif
+
+    // Fonts and images decode on the loader thread; the menu shows (without
+    // text) until the font is ready, which pollAssets picks up
+    font = loader.loadFont({
         "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
         "/usr/share/fonts/truetype/liberation/LiberationSans-Regular.ttf",
         "/System/Library/Fonts/Arial.ttf"
-    };
-    
-    bool fontLoaded = false;
-    for (const auto& path : fontPaths) {
-        if (font.loadFromFile(path)) {
-            fontLoaded = true;
-            break;
+    });
+
+    const std::string imageDir = std::string(CASSEBRIQUES_ASSET_DIR) + "/images/";
+    atlas = loader.loadAtlas(imageDir + "ball.png", imageDir + "brick.png", imageDir + "paddle.png");
+}
+
+void Game::pollAssets()
+{
+    if (!fontApplied && font.isReady()) {
+        fontApplied = true;
+        if (sf::Font* loaded = font.get()) {
+            frame.setFont(*loaded);
+        } else {
+            std::cout << "Warning: Could not load system font. Text may not display correctly." << std::endl;
         }
     }
-    
-    if (!fontLoaded) {
-        std::cout << "Warning: Could not load system font. Text may not display correctly." << std::endl;
+
+    // The texture must be created on this thread, which owns the GL context;
+    // the playfield stays in flat colours until then (or if an image is missing)
+    if (atlas.isValid() && atlas.isReady()) {
+        TextureAtlas* packed = atlas.get();
+        if (packed && atlasTexture.loadFromImage(packed->getImage())) {
+            atlasTexture.setSmooth(true);
+            frame.setAtlas(atlasTexture, *packed);
+        } else {
+            std::cout << "Warning: Could not load sprite images. Drawing flat colours." << std::endl;
+        }
+        atlas = AssetHandle<TextureAtlas>();
     }
-    
-    // Initialize paddle
-    float paddleX = WINDOW_WIDTH / 2.f - PADDLE_WIDTH / 2.f;
-    float paddleY = WINDOW_HEIGHT - PADDLE_HEIGHT - 20.f;
-    paddle = std::make_unique<Paddle>(paddleX, paddleY, PADDLE_WIDTH, PADDLE_HEIGHT);
 }
 
 int Game::run()
 {
-    while (window.isOpen()) {
-        float deltaTime = clock.restart().asSeconds();
-
-        handleEvents();
+    simulationThread.start();
+    double stepMicroseconds = Simulation::STEP_SECONDS * 1e6;
 
-        if (state == PLAYING) {
-            update(deltaTime);
+    while (window.isOpen()) {
+        // Closes the previous frame's samples before timing this one
+        CB_PROFILE_END_FRAME();
+        CB_PROFILE_SCOPE(Frame);
+
+        pollAssets();
+        const RenderSnapshot& snapshot = simulationThread.acquireSnapshot();
+        handleEvents(snapshot);
+
+        // Drawn one step behind the clock, between the snapshot's two positions
+        double sinceStep = static_cast<double>(InputQueue::now() - snapshot.tickEndMicroseconds);
+        float alpha = static_cast<float>(std::min(1.0, std::max(0.0, sinceStep / stepMicroseconds)));
+        draw(snapshot, alpha);
+#ifdef CASSEBRIQUES_PROFILING
+        if (showProfiler) {
+            drawProfiler();
         }
-
-        draw();
+#endif
+        window.display();
     }
 
+    simulationThread.stop();
+    saveRecording();
+#ifdef CASSEBRIQUES_PROFILING
+    if (Profiler::getInstance().writeCsv("profile.csv")) {
+        std::cout << "Frame timings written to profile.csv" << std::endl;
+    }
+#endif
     std::cout << "Goodbye from CasseBriques!" << std::endl;
     return 0;
 }
 
-void Game::initializeGame()
+void Game::recordTo(const std::string& path)
+{
+    recordPath = path;
+}
+
+bool Game::playFrom(const std::string& path)
 {
-    state = PLAYING;
-    lives = INITIAL_LIVES;
-    score = 0;
-    ballLaunched = false;
-    bricks.clear();
-    createBricks();
-    resetBall();
+    if (!player.loadFromFile(path)) {
+        std::cout << "Error: Could not load replay " << path << std::endl;
+        return false;
+    }
+
+    player.begin(simulation);
+    recorder.clear();
+    replaying = true;
+    return true;
+}
+
+bool Game::loadLevels(const std::string& path)
+{
+    if (!levels.open(path) || levels.getLevelCount() == 0) {
+        std::cout << "Error: Could not load level pack " << path << std::endl;
+        return false;
+    }
+
+    std::cout << "Loaded " << levels.getLevelCount() << " levels from " << path << std::endl;
+    return true;
 }
 
-void Game::createBricks()
+bool Game::playVersus(int side, const std::string& peer)
 {
-    float brickStartX = (WINDOW_WIDTH - (BRICK_COLS * (BRICK_WIDTH + BRICK_SPACING) - BRICK_SPACING)) / 2.f;
-    float brickStartY = 50.f;
-
-    for (int row = 0; row < BRICK_ROWS; ++row) {
-        for (int col = 0; col < BRICK_COLS; ++col) {
-            float x = brickStartX + col * (BRICK_WIDTH + BRICK_SPACING);
-            float y = brickStartY + row * (BRICK_HEIGHT + BRICK_SPACING);
-            int health = BRICK_ROWS - row;
-            bricks.push_back(std::make_unique<Brick>(x, y, BRICK_WIDTH, BRICK_HEIGHT, health));
+    unsigned short port = static_cast<unsigned short>(UdpLink::DEFAULT_PORT + side);
+    unsigned short peerPort = static_cast<unsigned short>(UdpLink::DEFAULT_PORT + 1 - side);
+    if (!link.open(port, sf::IpAddress(peer), peerPort)) {
+        std::cout << "Error: Could not bind UDP port " << port << std::endl;
+        return false;
+    }
+
+    if (side == 0) {
+        versus = std::make_unique<VersusSession>(simulation, opponent, side);
+    } else {
+        versus = std::make_unique<VersusSession>(opponent, simulation, side);
+    }
+    std::cout << "Versus: player " << side << " on port " << port << ", peer " << peer << ":" << peerPort
+              << std::endl;
+    return true;
+}
+
+void Game::startGame()
+{
+    // Runs on the simulation thread before its next step
+    auto restart = [this]() {
+        recorder.clear();
+        replaying = false;
+    };
+
+    if (versus) {
+        // Both peers must play the same level: always the first one
+        simulationThread.post([this, restart]() {
+            if (levels.getLevelCount() == 0) {
+                versus->start();
+            } else {
+                versus->start(levels.getLevel(0));
+            }
+            versusPlaying = true;
+            restart();
+        });
+    } else if (levels.getLevelCount() == 0) {
+        simulationThread.post([this, restart]() {
+            simulation.startGame();
+            restart();
+        });
+    } else {
+        // The previous level queued this one's bricks; normally they are long ready
+        BrickField* prefetched = levelIndex > 0 ? nextLevel.get() : nullptr;
+        if (prefetched) {
+            simulationThread.post([this, restart, bricks = *prefetched]() {
+                simulation.startGame(bricks);
+                restart();
+            });
+        } else {
+            simulationThread.post([this, restart, level = levels.getLevel(levelIndex)]() {
+                simulation.startGame(level);
+                restart();
+            });
+        }
+
+        nextLevel = AssetHandle<BrickField>();
+        if (levelIndex + 1 < levels.getLevelCount()) {
+            nextLevel = loader.loadLevel(levels, levelIndex + 1, static_cast<float>(WINDOW_WIDTH));
         }
     }
 }
 
-void Game::resetBall()
+void Game::saveRecording()
 {
-    float paddleX = paddle->getPosition().x;
-    float paddleY = paddle->getPosition().y;
-    float ballX = paddleX + PADDLE_WIDTH / 2.f - BALL_RADIUS;
-    float ballY = paddleY - BALL_RADIUS * 2.f;
-
-    ball = std::make_unique<Ball>(ballX, ballY, BALL_RADIUS, sf::Vector2f(0.f, 0.f));
-    ball->setGravityEnabled(false);
-    ballLaunched = false;
+    if (recordPath.empty() || recorder.getTickCount() == 0) {
+        return;
+    }
+
+    if (recorder.saveToFile(recordPath)) {
+        std::cout << "Replay saved to " << recordPath << " (" << recorder.getTickCount() << " ticks)" << std::endl;
+    } else {
+        std::cout << "Warning: Could not write replay " << recordPath << std::endl;
+    }
+    recorder.clear();
 }
 
-void Game::handleEvents()
+void Game::handleEvents(const RenderSnapshot& snapshot)
 {
+    CB_PROFILE_SCOPE(Events);
     sf::Event event;
     while (window.pollEvent(event)) {
         if (event.type == sf::Event::Closed) {
             window.close();
         } else if (event.type == sf::Event::KeyPressed) {
-            if (state == MENU && event.key.code == sf::Keyboard::Return) {
-                initializeGame();
-            } else if (state == PLAYING && event.key.code == sf::Keyboard::Space) {
-                if (!ballLaunched && ball) {
-                    float ballX = paddle->getPosition().x + PADDLE_WIDTH / 2.f - BALL_RADIUS;
-                    float ballY = paddle->getPosition().y - BALL_RADIUS * 2.f;
-                    ball->setPosition(ballX, ballY);
-                    ball->setVelocity(0.f, -BALL_SPEED);
-                    ball->setGravityEnabled(true);
-                    ballLaunched = true;
-                }
-            } else if ((state == GAME_OVER || state == VICTORY) && event.key.code == sf::Keyboard::Return) {
-                state = MENU;
+            // Until a posted transition shows up in a snapshot, the state it
+            // shows is stale: ignore keys that would post another one
+            bool current = simulationThread.isCurrent(snapshot);
+            Simulation::GameState state = current ? snapshot.state : Simulation::PLAYING;
+            if (state == Simulation::MENU && event.key.code == sf::Keyboard::Return) {
+                startGame();
+            } else if (state == Simulation::PLAYING && event.key.code == sf::Keyboard::Space) {
+                InputEvent launch;
+                launch.type = InputEvent::Launch;
+                launch.timeMicroseconds = InputQueue::now();
+                inputQueue.push(launch);
+            } else if (state == Simulation::PLAYING && event.key.code == sf::Keyboard::M) {
+                InputEvent multiBall;
+                multiBall.type = InputEvent::MultiBall;
+                multiBall.timeMicroseconds = InputQueue::now();
+                multiBall.count = 2;
+                inputQueue.push(multiBall);
+            } else if (state == Simulation::VICTORY && event.key.code == sf::Keyboard::Return && !versus &&
+                       levelIndex + 1 < levels.getLevelCount()) {
+                // Next level of the pack straight away; the pack is already mapped
+                ++levelIndex;
+                startGame();
+            } else if ((state == Simulation::GAME_OVER || state == Simulation::VICTORY) &&
+                       event.key.code == sf::Keyboard::Return) {
+                levelIndex = 0;
+                simulationThread.post([this]() {
+                    simulation.returnToMenu();
+                    versusPlaying = false;
+                });
             } else if (event.key.code == sf::Keyboard::Escape) {
                 window.close();
             }
         }
 
+        if (event.type == sf::Event::MouseMoved) {
+            // The paddle follows the mouse
+            InputEvent move;
+            move.type = InputEvent::PaddleMove;
+            move.timeMicroseconds = InputQueue::now();
+            move.x = static_cast<float>(event.mouseMove.x);
+            inputQueue.push(move);
+        }
+
         InputManager::getInstance().processEvent(event);
     }
+    InputManager::getInstance().dispatch();
 }
 
-void Game::update(float deltaTime)
+void Game::update(std::int64_t tickEndMicroseconds)
 {
-    // Update paddle position with mouse
-    sf::Vector2i mousePos = sf::Mouse::getPosition(window);
-    float targetX = static_cast<float>(mousePos.x) - PADDLE_WIDTH / 2.f;
-    targetX = std::max(0.f, std::min(targetX, static_cast<float>(WINDOW_WIDTH) - PADDLE_WIDTH));
-    paddle->setPosition(targetX, WINDOW_HEIGHT - PADDLE_HEIGHT - 20.f);
-    paddle->update(deltaTime);
-
-    // Update bricks
-    for (auto& brick : bricks) {
-        brick->update(deltaTime);
-    }
-
-    // Update ball
-    if (!ballLaunched && ball) {
-        float ballX = paddle->getPosition().x + PADDLE_WIDTH / 2.f - BALL_RADIUS;
-        float ballY = paddle->getPosition().y - BALL_RADIUS * 2.f;
-        ball->setPosition(ballX, ballY);
-        ball->setVelocity(0.f, 0.f);
-        ball->setGravityEnabled(false);
-        ball->update(0.f);
-    } else if (ball && ballLaunched) {
-        ball->update(deltaTime);
-        ball->bounceOffWalls(static_cast<float>(WINDOW_WIDTH), static_cast<float>(WINDOW_HEIGHT));
-
-        // Collision with paddle
-        if (ball->checkCollisionWithAABB(paddle->getBounds())) {
-            sf::Vector2f ballCenter = ball->getPosition() + sf::Vector2f(BALL_RADIUS, BALL_RADIUS);
-            float paddleCenterX = paddle->getPosition().x + PADDLE_WIDTH / 2.f;
-            float hitPosition = (ballCenter.x - paddleCenterX) / (PADDLE_WIDTH / 2.f);
-            hitPosition = std::max(-1.f, std::min(1.f, hitPosition));
-
-            float angle = hitPosition * 60.f * 3.14159265f / 180.f;
-            float speed = std::sqrt(ball->getVelocity().x * ball->getVelocity().x +
-                                   ball->getVelocity().y * ball->getVelocity().y);
-            if (speed < BALL_SPEED * 0.5f) speed = BALL_SPEED;
-
-            sf::Vector2f newVelocity(std::sin(angle) * speed, -std::abs(std::cos(angle) * speed));
-            ball->setVelocity(newVelocity);
-            ball->setPosition(ball->getPosition().x, paddle->getPosition().y - BALL_RADIUS * 2.f);
-        }
+    // Drained even during a replay or outside of play, so live input does not
+    // pile up; outside of play the paddle target still follows the mouse
+    SimulationInput input = inputQueue.drain(tickEndMicroseconds);
+    if (versus) {
+        updateVersus(input);
+        return;
+    }
+    if (simulation.getState() != Simulation::PLAYING) {
+        saveRecording();
+        return;
+    }
 
-        // Collision with bricks
-        for (auto& brick : bricks) {
-            if (!brick->isDestroyed() && ball->checkCollisionWithAABB(brick->getAABB())) {
-                ball->handleCollisionWithAABB(brick->getAABB());
-                brick->takeDamage(1);
-                if (brick->isDestroyed()) {
-                    score += 10;
-                }
-            }
-        }
+    if (replaying && player.next(input)) {
+        simulation.step(input);
+        return;
+    }
+    replaying = false;
 
-        // Check if ball is out of bounds
-        if (ball->isOutOfBounds(static_cast<float>(WINDOW_HEIGHT))) {
-            lives--;
-            if (lives <= 0) {
-                state = GAME_OVER;
-            } else {
-                resetBall();
-            }
-        }
+    if (!recordPath.empty()) {
+        recorder.record(input);
     }
+    simulation.step(input);
+}
 
-    // Check for victory
-    bool allDestroyed = std::all_of(bricks.begin(), bricks.end(),
-                                     [](const auto& brick) { return brick->isDestroyed(); });
-    if (allDestroyed && !bricks.empty()) {
-        state = VICTORY;
+void Game::updateVersus(const SimulationInput& input)
+{
+    // Packets keep flowing after our field is over: the peer still needs our
+    // inputs to settle its own ticks
+    std::array<unsigned char, VersusSession::MAX_PACKET_SIZE> packet;
+    std::size_t size = 0;
+    link.update();
+    while (link.receive(packet.data(), packet.size(), size)) {
+        versus->readPacket(packet.data(), size);
+    }
+    if (!versusPlaying) {
+        return;
     }
 
-    // Clean up destroyed bricks
-    bricks.erase(
-        std::remove_if(bricks.begin(), bricks.end(),
-                      [](const auto& brick) { return brick->isDestroyed(); }),
-        bricks.end());
+    // A tick the session refuses is skipped: the peer is too far behind
+    versus->settle();
+    bool over = versus->isFinished() && versus->isSettled();
+    if (!over && versus->canAdvance()) {
+        versus->advance(input);
+        over = versus->isFinished() && versus->isSettled();
+    }
+    size = versus->writePacket(packet.data(), packet.size());
+    link.send(packet.data(), size);
+
+    if (over) {
+        const VersusSession::Stats& stats = versus->getStats();
+        int winner = versus->getWinner();
+        const char* result = winner < 0 ? "draw" : (winner == versus->getLocalPlayer() ? "you win" : "you lose");
+        double rollbacks = static_cast<double>(std::max<std::uint64_t>(stats.rollbacks, 1));
+        std::cout << "Versus: " << result << " (" << simulation.getScore() << " - " << opponent.getScore() << "), "
+                  << stats.rollbacks << " rollbacks, max depth " << stats.maxRollbackDepth << ", resimulation "
+                  << stats.totalResimulationMicroseconds / rollbacks << " us mean / "
+                  << stats.maxResimulationMicroseconds << " us max" << std::endl;
+        versusPlaying = false;
+    }
 }
 
-void Game::draw()
+void Game::draw(const RenderSnapshot& snapshot, float alpha)
 {
-    window.clear(sf::Color::Black);
-
-    if (state == MENU) {
-        sf::Text title;
-        title.setFont(font);
-        title.setString("CASSE BRIQUES");
-        title.setCharacterSize(48);
-        title.setFillColor(sf::Color::White);
-        title.setPosition(WINDOW_WIDTH / 2.f - 150.f, WINDOW_HEIGHT / 2.f - 100.f);
-        window.draw(title);
-
-        sf::Text startText;
-        startText.setFont(font);
-        startText.setString("Appuyez sur ENTREE pour commencer");
-        startText.setCharacterSize(24);
-        startText.setFillColor(sf::Color::Yellow);
-        startText.setPosition(WINDOW_WIDTH / 2.f - 180.f, WINDOW_HEIGHT / 2.f + 50.f);
-        window.draw(startText);
-    } else if (state == PLAYING) {
-        for (const auto& brick : bricks) {
-            brick->draw(window);
-        }
-        paddle->draw(window);
-        if (ball) {
-            ball->draw(window);
-        }
+    CB_PROFILE_SCOPE(Render);
+    frame.draw(window, snapshot, alpha);
+}
 
-        sf::Text livesText;
-        livesText.setFont(font);
-        livesText.setString("Vies: " + std::to_string(lives));
-        livesText.setCharacterSize(20);
-        livesText.setFillColor(sf::Color::White);
-        livesText.setPosition(10.f, 10.f);
-        window.draw(livesText);
-
-        sf::Text scoreText;
-        scoreText.setFont(font);
-        scoreText.setString("Score: " + std::to_string(score));
-        scoreText.setCharacterSize(20);
-        scoreText.setFillColor(sf::Color::White);
-        scoreText.setPosition(WINDOW_WIDTH - 200.f, 10.f);
-        window.draw(scoreText);
-    } else if (state == GAME_OVER) {
-        for (const auto& brick : bricks) {
-            brick->draw(window);
-        }
-        paddle->draw(window);
-        if (ball) {
-            ball->draw(window);
-        }
+#ifdef CASSEBRIQUES_PROFILING
+void Game::onKeyPressed(const KeyPressedEvent& event)
+{
+    if (event.key == sf::Keyboard::F3) {
+        showProfiler = !showProfiler;
+    }
+}
 
-        sf::RectangleShape overlay(sf::Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT));
-        overlay.setFillColor(sf::Color(0, 0, 0, 200));
-        window.draw(overlay);
-
-        sf::Text gameOverText;
-        gameOverText.setFont(font);
-        gameOverText.setString("GAME OVER");
-        gameOverText.setCharacterSize(64);
-        gameOverText.setFillColor(sf::Color::Red);
-        gameOverText.setPosition(WINDOW_WIDTH / 2.f - 180.f, WINDOW_HEIGHT / 2.f - 100.f);
-        window.draw(gameOverText);
-
-        sf::Text scoreText;
-        scoreText.setFont(font);
-        scoreText.setString("Score final: " + std::to_string(score));
-        scoreText.setCharacterSize(32);
-        scoreText.setFillColor(sf::Color::White);
-        scoreText.setPosition(WINDOW_WIDTH / 2.f - 150.f, WINDOW_HEIGHT / 2.f);
-        window.draw(scoreText);
-
-        sf::Text restartText;
-        restartText.setFont(font);
-        restartText.setString("Appuyez sur ENTREE pour revenir au menu");
-        restartText.setCharacterSize(20);
-        restartText.setFillColor(sf::Color::Yellow);
-        restartText.setPosition(WINDOW_WIDTH / 2.f - 200.f, WINDOW_HEIGHT / 2.f + 100.f);
-        window.draw(restartText);
-    } else if (state == VICTORY) {
-        for (const auto& brick : bricks) {
-            brick->draw(window);
-        }
-        paddle->draw(window);
-        if (ball) {
-            ball->draw(window);
-        }
+void Game::drawProfiler()
+{
+    const Profiler& profiler = Profiler::getInstance();
+
+    std::string lines = "section          min    avg    p99 (us)\n";
+    char row[96];
+    for (std::size_t i = 0; i < Profiler::SECTION_COUNT; ++i) {
+        ProfileSection section = static_cast<ProfileSection>(i);
+        Profiler::Stats stats = profiler.getStats(section);
+        std::snprintf(row, sizeof(row), "%-15s %6.0f %6.0f %6.0f\n", Profiler::getSectionName(section),
+                      stats.minMicroseconds, stats.avgMicroseconds, stats.p99Microseconds);
+        lines += row;
+    }
+
+    sf::RectangleShape background(sf::Vector2f(330.f, 20.f * (Profiler::SECTION_COUNT + 1) + 10.f));
+    background.setFillColor(sf::Color(0, 0, 0, 180));
+    background.setPosition(10.f, 40.f);
+    window.draw(background);
 
-        sf::RectangleShape overlay(sf::Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT));
-        overlay.setFillColor(sf::Color(0, 0, 0, 200));
-        window.draw(overlay);
-
-        sf::Text victoryText;
-        victoryText.setFont(font);
-        victoryText.setString("VICTOIRE!");
-        victoryText.setCharacterSize(64);
-        victoryText.setFillColor(sf::Color::Green);
-        victoryText.setPosition(WINDOW_WIDTH / 2.f - 160.f, WINDOW_HEIGHT / 2.f - 100.f);
-        window.draw(victoryText);
-
-        sf::Text scoreText;
-        scoreText.setFont(font);
-        scoreText.setString("Score final: " + std::to_string(score));
-        scoreText.setCharacterSize(32);
-        scoreText.setFillColor(sf::Color::White);
-        scoreText.setPosition(WINDOW_WIDTH / 2.f - 150.f, WINDOW_HEIGHT / 2.f);
-        window.draw(scoreText);
-
-        sf::Text restartText;
-        restartText.setFont(font);
-        restartText.setString("Appuyez sur ENTREE pour revenir au menu");
-        restartText.setCharacterSize(20);
-        restartText.setFillColor(sf::Color::Yellow);
-        restartText.setPosition(WINDOW_WIDTH / 2.f - 200.f, WINDOW_HEIGHT / 2.f + 100.f);
-        window.draw(restartText);
-    }
-
-    window.display();
+    sf::Text text;
+    if (sf::Font* loaded = fontApplied ? font.get() : nullptr) {
+        text.setFont(*loaded);
+    }
+    text.setString(lines);
+    text.setCharacterSize(14);
+    text.setFillColor(sf::Color::Green);
+    text.setPosition(15.f, 45.f);
+    window.draw(text);
 }
+#endif
 
-void Game::checkGameOver()
+int main(int argc, char* argv[])
 {
-    if (ball->isOutOfBounds(static_cast<float>(WINDOW_HEIGHT))) {
-        lives--;
-        if (lives <= 0) {
-            state = GAME_OVER;
+    const char* usage = "Usage: CasseBriquesGame [--record <file> | --play <file>] [--levels <pack.cblv>]\n"
+                        "                        [--versus <0|1> [--peer <host>]]";
+    std::string recordPath;
+    std::string playPath;
+    std::string levelsPath;
+    int versusSide = -1;
+    std::string peer = "127.0.0.1";
+    bool peerGiven = false;
+
+    // Check every option before the window opens
+    for (int i = 1; i < argc; i += 2) {
+        std::string option = argv[i];
+        if (i + 1 == argc) {
+            std::cout << "Error: " << option << " needs a value" << std::endl;
+            std::cout << usage << std::endl;
+            return 1;
+        }
+        std::string value = argv[i + 1];
+        if (option == "--record") {
+            recordPath = value;
+        } else if (option == "--play") {
+            playPath = value;
+        } else if (option == "--levels") {
+            levelsPath = value;
+        } else if (option == "--versus" && (value == "0" || value == "1")) {
+            versusSide = value[0] - '0';
+        } else if (option == "--peer") {
+            peer = value;
+            peerGiven = true;
         } else {
-            resetBall();
+            std::cout << usage << std::endl;
+            return 1;
         }
     }
-}
 
-int main()
-{
+    bool replayOption = !recordPath.empty() || !playPath.empty();
+    if (!recordPath.empty() && !playPath.empty()) {
+        std::cout << "Error: --record cannot be combined with --play" << std::endl;
+        std::cout << usage << std::endl;
+        return 1;
+    }
+
+    // Replays always start on the default wall
+    if (replayOption && !levelsPath.empty()) {
+        std::cout << "Error: --levels cannot be combined with --record or --play" << std::endl;
+        std::cout << usage << std::endl;
+        return 1;
+    }
+
+    // Versus matches are live: nothing to record or replay
+    if (versusSide >= 0 && replayOption) {
+        std::cout << "Error: --versus cannot be combined with --record or --play" << std::endl;
+        std::cout << usage << std::endl;
+        return 1;
+    }
+
+    // A peer means nothing outside a versus match
+    if (peerGiven && versusSide < 0) {
+        std::cout << "Error: --peer needs --versus" << std::endl;
+        std::cout << usage << std::endl;
+        return 1;
+    }
+
     Game game;
+    if (!recordPath.empty()) {
+        game.recordTo(recordPath);
+    }
+    if (!playPath.empty() && !game.playFrom(playPath)) {
+        return 1;
+    }
+    if (!levelsPath.empty() && !game.loadLevels(levelsPath)) {
+        return 1;
+    }
+    if (versusSide >= 0 && !game.playVersus(versusSide, peer)) {
+        return 1;
+    }
+
     return game.run();
 }
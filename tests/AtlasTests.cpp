@@ -0,0 +1,92 @@
+// Packing of the sprite atlas: every rect inside the atlas, none overlapping
+// another (padding included), and the whole dense enough to be worth it.
+#include "Catch.hpp"
+#include "TextureAtlas.hpp"
+#include <vector>
+
+namespace
+{
+constexpr float MIN_DENSITY{0.7f};
+
+void requireValidPacking(const sf::Vector2u& size, const std::vector<sf::IntRect>& rects, float density,
+                         unsigned int padding)
+{
+    int gap = static_cast<int>(padding);
+    for (std::size_t i = 0; i < rects.size(); ++i)
+    {
+        INFO("rect " << i);
+        const sf::IntRect& rect = rects[i];
+        REQUIRE(rect.width > 0);
+        REQUIRE(rect.height > 0);
+        REQUIRE(rect.left >= 0);
+        REQUIRE(rect.top >= 0);
+        REQUIRE(rect.left + rect.width <= static_cast<int>(size.x));
+        REQUIRE(rect.top + rect.height <= static_cast<int>(size.y));
+
+        sf::IntRect padded(rect.left - gap, rect.top - gap, rect.width + gap * 2, rect.height + gap * 2);
+        for (std::size_t j = i + 1; j < rects.size(); ++j)
+        {
+            INFO("overlaps rect " << j);
+            sf::IntRect overlap;
+            REQUIRE_FALSE((padded.intersects(rects[j], overlap) && overlap.width > 0 && overlap.height > 0));
+        }
+    }
+    CHECK(density >= MIN_DENSITY);
+}
+
+sf::Image solidImage(unsigned int width, unsigned int height, const sf::Color& color)
+{
+    sf::Image image;
+    image.create(width, height, color);
+    return image;
+}
+} // namespace
+
+// Sizes of the shipped PNGs
+TEST_CASE("The sprite atlas packs the shipped images densely", "[atlas]")
+{
+    sf::Image ball = solidImage(512, 512, sf::Color::White);
+    sf::Image brick = solidImage(1024, 512, sf::Color(200, 200, 200));
+    sf::Image paddle = solidImage(1024, 256, sf::Color::White);
+
+    TextureAtlas atlas;
+    REQUIRE(atlas.build(ball, brick, paddle));
+
+    std::vector<sf::IntRect> rects;
+    for (std::size_t i = 0; i < TextureAtlas::SPRITE_COUNT; ++i)
+    {
+        rects.push_back(atlas.getRect(static_cast<AtlasSprite>(i)));
+    }
+    requireValidPacking(atlas.getImage().getSize(), rects, atlas.getDensity(), TextureAtlas::PADDING);
+}
+
+TEST_CASE("An empty image fails the atlas build", "[atlas]")
+{
+    sf::Image ball = solidImage(512, 512, sf::Color::White);
+    sf::Image paddle = solidImage(1024, 256, sf::Color::White);
+    TextureAtlas atlas;
+    CHECK_FALSE(atlas.build(ball, sf::Image(), paddle));
+}
+
+// Packer alone over a mixed set of sprite sizes (e.g. more brick types later)
+TEST_CASE("packAtlas packs mixed sprite sizes densely", "[atlas]")
+{
+    for (int count : {1, 8, 32})
+    {
+        INFO(count << " sprites");
+        std::vector<sf::Vector2u> sizes;
+        for (int i = 0; i < count; ++i)
+        {
+            sizes.emplace_back(16u + (i * 37u) % 112u, 16u + (i * 23u) % 48u);
+        }
+
+        AtlasPacking packing = packAtlas(sizes, TextureAtlas::PADDING);
+        REQUIRE(packing.rects.size() == sizes.size());
+        for (std::size_t i = 0; i < sizes.size(); ++i)
+        {
+            REQUIRE(packing.rects[i].width == static_cast<int>(sizes[i].x));
+            REQUIRE(packing.rects[i].height == static_cast<int>(sizes[i].y));
+        }
+        requireValidPacking(packing.size, packing.rects, packing.getDensity(), TextureAtlas::PADDING);
+    }
+}
@@ -0,0 +1,3 @@
+// Test runner for Catch2 2.x; with Catch2 3 the tests link Catch2::Catch2WithMain instead
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
@@ -0,0 +1,62 @@
+// The batched brick sweep: every SIMD path this build and CPU can run must
+// match the scalar path bit for bit, or replays would depend on the CPU.
+#include "BenchLayouts.hpp"
+#include "Catch.hpp"
+#include "CollisionBatch.hpp"
+#include <cstring>
+
+namespace
+{
+bool sameBits(float a, float b)
+{
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+bool sameResult(bool found, const collision::SweepBatchHit& result, bool referenceFound,
+                const collision::SweepBatchHit& reference)
+{
+    if (found != referenceFound || result.hitMask != reference.hitMask)
+    {
+        return false;
+    }
+    return !found || (result.earliest == reference.earliest && sameBits(result.hit.time, reference.hit.time) &&
+                      sameBits(result.hit.normal.x, reference.hit.normal.x) &&
+                      sameBits(result.hit.normal.y, reference.hit.normal.y) &&
+                      result.hit.startedInside == reference.hit.startedInside);
+}
+} // namespace
+
+TEST_CASE("Batched sweeps match the scalar path bit for bit", "[collision]")
+{
+    std::vector<bench::SweepBatchCase> cases = bench::makeSweepBatchCases();
+
+    for (collision::SweepBatchPath path : {collision::SweepBatchPath::Sse2, collision::SweepBatchPath::Avx2})
+    {
+        if (!collision::isSweepBatchPathSupported(path))
+        {
+            WARN(collision::getSweepBatchPathName(path) << " not supported on this build or CPU, not checked");
+            continue;
+        }
+
+        std::size_t hits = 0;
+        for (std::size_t i = 0; i < cases.size(); ++i)
+        {
+            const bench::SweepBatchCase& batch = cases[i];
+            collision::SweepBatchHit result;
+            collision::SweepBatchHit reference;
+            bool found = collision::sweepCircleBoxes(path, batch.center, batch.displacement, Simulation::BALL_RADIUS,
+                                                     batch.boxes, result);
+            bool referenceFound = collision::sweepCircleBoxes(collision::SweepBatchPath::Scalar, batch.center,
+                                                              batch.displacement, Simulation::BALL_RADIUS,
+                                                              batch.boxes, reference);
+            if (!sameResult(found, result, referenceFound, reference))
+            {
+                FAIL(collision::getSweepBatchPathName(path) << " differs from the scalar path on batch " << i);
+            }
+            hits += found;
+        }
+        // The cases must exercise contacts as well as misses
+        CHECK(hits > cases.size() / 10);
+        CHECK(hits < cases.size());
+    }
+}
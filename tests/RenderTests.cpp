@@ -0,0 +1,174 @@
+// Headless checks of what the renderers prepare for a frame: no window or GPU,
+// only the vertices and texts they would draw.
+#include "AllocationCounter.hpp"
+#include "BatchRenderer.hpp"
+#include "Brick.hpp"
+#include "Catch.hpp"
+#include "Hud.hpp"
+#include "RenderSnapshot.hpp"
+
+namespace
+{
+// Vertices of brick `index` that would show up on screen
+std::size_t visibleBrickVertices(const BatchRenderer& renderer, std::size_t index)
+{
+    std::size_t visible = 0;
+    for (std::size_t i = 0; i < BatchRenderer::VERTICES_PER_BRICK; ++i)
+    {
+        visible += renderer.getVertex(index * BatchRenderer::VERTICES_PER_BRICK + i).color.a != 0;
+    }
+    return visible;
+}
+
+// Fill colour of brick `index` (its second rectangle)
+sf::Color brickFill(const BatchRenderer& renderer, std::size_t index)
+{
+    return renderer.getVertex(index * BatchRenderer::VERTICES_PER_BRICK + BatchRenderer::VERTICES_PER_RECT).color;
+}
+
+void requireBrickVertices(const BatchRenderer& renderer, const BrickField& bricks)
+{
+    for (std::size_t i = 0; i < bricks.size(); ++i)
+    {
+        INFO("brick " << i);
+        REQUIRE(visibleBrickVertices(renderer, i) == (bricks.isAlive(i) ? BatchRenderer::VERTICES_PER_BRICK : 0));
+    }
+}
+} // namespace
+
+// The whole field sits in one vertex array: VERTICES_PER_BRICK per brick
+// slot, then the paddle and the balls. After the first frame only the bricks
+// hit since the previous one are rewritten.
+TEST_CASE("BatchRenderer rewrites only the bricks that changed", "[render]")
+{
+    constexpr std::size_t BRICKS{12};
+    constexpr std::size_t PADDLE_VERTICES{BatchRenderer::VERTICES_PER_RECT * 2};
+    constexpr std::size_t BALL_VERTICES{BatchRenderer::BALL_SEGMENTS * 3};
+
+    RenderSnapshot snapshot;
+    snapshot.paddleSize = sf::Vector2f(Simulation::PADDLE_WIDTH, Simulation::PADDLE_HEIGHT);
+    for (std::size_t i = 0; i < BRICKS; ++i)
+    {
+        snapshot.bricks.add(10.f + 75.f * static_cast<float>(i % 6), 50.f + 35.f * static_cast<float>(i / 6), 70.f,
+                            30.f, 3);
+    }
+    snapshot.balls.spawn(sf::Vector2f(400.f, 300.f), sf::Vector2f(0.f, -400.f), true);
+
+    BatchRenderer renderer;
+    renderer.update(snapshot);
+    REQUIRE(renderer.getLastRebuiltBrickCount() == BRICKS);
+    REQUIRE(renderer.getVertexCount() == BRICKS * BatchRenderer::VERTICES_PER_BRICK + PADDLE_VERTICES + BALL_VERTICES);
+    requireBrickVertices(renderer, snapshot.bricks);
+
+    SECTION("an unchanged field rewrites no brick")
+    {
+        renderer.update(snapshot);
+        REQUIRE(renderer.getLastRebuiltBrickCount() == 0);
+        requireBrickVertices(renderer, snapshot.bricks);
+    }
+
+    SECTION("damaged and destroyed bricks are the only ones rewritten")
+    {
+        sf::Color fullHealth = brickFill(renderer, 1);
+        snapshot.bricks.takeDamage(1);
+        snapshot.bricks.takeDamage(7, 2);
+        snapshot.bricks.destroy(4);
+        snapshot.bricks.destroy(10);
+
+        renderer.update(snapshot);
+        REQUIRE(renderer.getLastRebuiltBrickCount() == 4);
+        REQUIRE(renderer.getVertexCount() ==
+                BRICKS * BatchRenderer::VERTICES_PER_BRICK + PADDLE_VERTICES + BALL_VERTICES);
+        requireBrickVertices(renderer, snapshot.bricks);
+        REQUIRE(visibleBrickVertices(renderer, 4) == 0);
+        REQUIRE(visibleBrickVertices(renderer, 10) == 0);
+
+        // Damaged bricks change colour with their health state
+        Brick::HealthState damaged = Brick::healthState(snapshot.bricks.getHealth(7), snapshot.bricks.getMaxHealth(7));
+        CHECK(brickFill(renderer, 7) == Brick::colorForState(damaged));
+        CHECK(brickFill(renderer, 0) == fullHealth);
+
+        renderer.update(snapshot);
+        REQUIRE(renderer.getLastRebuiltBrickCount() == 0);
+    }
+
+    SECTION("a new level rebuilds every brick")
+    {
+        BrickField level;
+        level.add(100.f, 100.f, 70.f, 30.f, 1);
+        level.add(200.f, 100.f, 70.f, 30.f, 1);
+        snapshot.bricks = level;
+
+        renderer.update(snapshot);
+        REQUIRE(renderer.getLastRebuiltBrickCount() == 2);
+        REQUIRE(renderer.getVertexCount() == 2 * BatchRenderer::VERTICES_PER_BRICK + PADDLE_VERTICES + BALL_VERTICES);
+        requireBrickVertices(renderer, snapshot.bricks);
+    }
+}
+
+// Texts are only laid out again when the value they show changes, into
+// buffers sized up front: neither steady frames nor score changes allocate.
+TEST_CASE("Hud rebuilds only changed texts, without allocating", "[render][allocations]")
+{
+    constexpr int FRAMES{1000};
+    Hud hud;
+    hud.update(Simulation::PLAYING, 3, 0); // First frame lays everything out
+    REQUIRE(hud.getLastRebuiltTextCount() == 2);
+
+    SECTION("steady frames")
+    {
+        std::size_t before = bench::allocationCount();
+        int rebuilt = 0;
+        for (int frame = 0; frame < FRAMES; ++frame)
+        {
+            hud.update(Simulation::PLAYING, 3, 0);
+            rebuilt += hud.getLastRebuiltTextCount();
+        }
+        CHECK(rebuilt == 0);
+        CHECK(bench::allocationCount() - before == 0);
+    }
+
+    SECTION("a score change every frame, up to seven digits")
+    {
+        std::size_t before = bench::allocationCount();
+        int rebuilt = 0;
+        for (int frame = 1; frame <= FRAMES; ++frame)
+        {
+            hud.update(Simulation::PLAYING, 3, frame * 1237);
+            rebuilt += hud.getLastRebuiltTextCount();
+        }
+        CHECK(rebuilt == FRAMES);
+        CHECK(bench::allocationCount() - before == 0);
+    }
+
+    SECTION("end screens")
+    {
+        hud.update(Simulation::GAME_OVER, 0, 450);
+        CHECK(hud.getLastRebuiltTextCount() == 1);
+        std::size_t before = bench::allocationCount();
+        hud.update(Simulation::GAME_OVER, 0, 450);
+        CHECK(hud.getLastRebuiltTextCount() == 0);
+        hud.update(Simulation::VICTORY, 1, 990);
+        CHECK(hud.getLastRebuiltTextCount() == 1);
+        CHECK(bench::allocationCount() - before == 0);
+    }
+}
+
+// Everything the game prepares for a frame of a resting game: HUD and vertices
+TEST_CASE("Preparing a steady frame allocates nothing", "[render][allocations]")
+{
+    Hud hud;
+    Simulation simulation;
+    simulation.startGame();
+    BatchRenderer renderer;
+    renderer.update(simulation);
+    hud.update(simulation.getState(), simulation.getLives(), simulation.getScore());
+
+    std::size_t before = bench::allocationCount();
+    for (int frame = 0; frame < 1000; ++frame)
+    {
+        renderer.update(simulation, 0.5f);
+        hud.update(simulation.getState(), simulation.getLives(), simulation.getScore());
+    }
+    CHECK(bench::allocationCount() - before == 0);
+}
@@ -0,0 +1,215 @@
+// Gameplay rules of the headless simulation, over fixed numbers of steps.
+#include "AllocationCounter.hpp"
+#include "Catch.hpp"
+#include "FixedTimestep.hpp"
+#include "Simulation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+// Penetration a ball may show into a brick after a step: contacts stop 0.01 px short
+constexpr float OVERLAP_TOLERANCE{0.05f};
+
+bool overlapsLiveBrick(const BrickField& bricks, const sf::Vector2f& center)
+{
+    for (std::size_t i = 0; i < bricks.size(); ++i)
+    {
+        if (!bricks.isAlive(i))
+        {
+            continue;
+        }
+        sf::FloatRect box = bricks.getAABB(i);
+        float closestX = std::clamp(center.x, box.left, box.left + box.width);
+        float closestY = std::clamp(center.y, box.top, box.top + box.height);
+        float dx = center.x - closestX;
+        float dy = center.y - closestY;
+        float reach = Simulation::BALL_RADIUS - OVERLAP_TOLERANCE;
+        if (dx * dx + dy * dy < reach * reach)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// The centre moved into `box` on the way from `from` to `to` (slab test). A
+// ball that bounces stops a radius short of the box, so its path never does.
+bool pathEntersBox(const sf::FloatRect& box, const sf::Vector2f& from, const sf::Vector2f& to)
+{
+    float enter = 0.f;
+    float exit = 1.f;
+    const float start[2] = {from.x, from.y};
+    const float delta[2] = {to.x - from.x, to.y - from.y};
+    const float low[2] = {box.left, box.top};
+    const float high[2] = {box.left + box.width, box.top + box.height};
+    for (int axis = 0; axis < 2; ++axis)
+    {
+        if (delta[axis] == 0.f)
+        {
+            if (start[axis] < low[axis] || start[axis] > high[axis])
+            {
+                return false;
+            }
+            continue;
+        }
+        float t0 = (low[axis] - start[axis]) / delta[axis];
+        float t1 = (high[axis] - start[axis]) / delta[axis];
+        enter = std::max(enter, std::min(t0, t1));
+        exit = std::min(exit, std::max(t0, t1));
+    }
+    return enter <= exit;
+}
+
+sf::Vector2f ballCenter(const BallField& balls, std::size_t ball)
+{
+    return balls.getPosition(ball) + sf::Vector2f(Simulation::BALL_RADIUS, Simulation::BALL_RADIUS);
+}
+} // namespace
+
+// Balls at ten times the launch speed, stepped through long frames (the
+// maximum steps per frame): a ball moves about 33 px a step, more than the
+// 15 px paddle or a 30 px brick row. No ball may end a step inside a live
+// brick, and no ball's path may enter the paddle or a brick it did not hit.
+TEST_CASE("Fast balls do not tunnel through bricks or the paddle", "[simulation]")
+{
+    constexpr int FRAMES{2500};
+    constexpr float SPEED_MULTIPLIER{10.f};
+    constexpr double LONG_FRAME_SECONDS{Simulation::MAX_STEPS_PER_FRAME * static_cast<double>(Simulation::STEP_SECONDS)};
+
+    Simulation simulation;
+    simulation.setBallSpeedMultiplier(SPEED_MULTIPLIER);
+    FixedTimestep timestep(Simulation::STEP_SECONDS, Simulation::MAX_STEPS_PER_FRAME);
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> randomAim(-0.45f * Simulation::PADDLE_WIDTH, 0.45f * Simulation::PADDLE_WIDTH);
+
+    std::vector<sf::Vector2f> centers;
+    std::vector<int> health;
+    SimulationInput input;
+    float aim = 0.f;
+    int aimedBounce = -1;
+    float fastestStep = 0.f;
+    int step = 0;
+
+    simulation.startGame();
+    for (int frame = 0; frame < FRAMES; ++frame)
+    {
+        int frameSteps = timestep.advance(LONG_FRAME_SECONDS);
+        for (int i = 0; i < frameSteps; ++i, ++step)
+        {
+            if (simulation.getState() != Simulation::PLAYING)
+            {
+                simulation.startGame();
+            }
+
+            // Aim somewhere new after every rebound so the wall is hit at many angles
+            if (simulation.getPaddleBounces() != aimedBounce)
+            {
+                aimedBounce = simulation.getPaddleBounces();
+                aim = randomAim(random);
+            }
+            const BallField& balls = simulation.getBalls();
+            const BrickField& bricks = simulation.getBricks();
+            input.paddleTargetX = balls.empty() ? 0.f : balls.getPosition(0).x + Simulation::BALL_RADIUS - aim;
+            input.launch = !simulation.isBallLaunched();
+            input.multiBall = input.launch ? 2 : 0;
+
+            centers.clear();
+            for (std::size_t ball = 0; ball < balls.size(); ++ball)
+            {
+                centers.push_back(ballCenter(balls, ball));
+            }
+            health.assign(bricks.size(), 0);
+            for (std::size_t brick = 0; brick < bricks.size(); ++brick)
+            {
+                health[brick] = bricks.isAlive(brick) ? bricks.getHealth(brick) : 0;
+            }
+            sf::FloatRect paddleBefore = simulation.getPaddle().getBounds();
+            bool launched = simulation.isBallLaunched();
+
+            simulation.step(input);
+
+            // Lost balls reorder the rest; only compare steps that kept every ball
+            if (!launched || simulation.getState() != Simulation::PLAYING || balls.size() != centers.size())
+            {
+                continue;
+            }
+            sf::FloatRect paddleAfter = simulation.getPaddle().getBounds();
+            for (std::size_t ball = 0; ball < balls.size(); ++ball)
+            {
+                sf::Vector2f from = centers[ball];
+                sf::Vector2f to = ballCenter(balls, ball);
+                fastestStep = std::max(fastestStep, std::hypot(to.x - from.x, to.y - from.y));
+
+                if (overlapsLiveBrick(bricks, to))
+                {
+                    FAIL("ball " << ball << " ended step " << step << " inside a live brick");
+                }
+                // From above only: a ball already below the top is lifted back onto a paddle moving into it
+                if (from.y < paddleBefore.top && pathEntersBox(paddleBefore, from, to) &&
+                    pathEntersBox(paddleAfter, from, to))
+                {
+                    FAIL("ball " << ball << " passed through the paddle on step " << step);
+                }
+                for (std::size_t brick = 0; brick < bricks.size(); ++brick)
+                {
+                    if (health[brick] > 0 && bricks.getHealth(brick) == health[brick] &&
+                        pathEntersBox(bricks.getAABB(brick), from, to))
+                    {
+                        FAIL("ball " << ball << " passed through brick " << brick << " without hitting it on step "
+                                     << step);
+                    }
+                }
+            }
+        }
+    }
+
+    // At 10x a step covers about 33 px; anything much slower proves nothing
+    CHECK(fastestStep > 25.f);
+}
+
+// The default wall played start to finish and restarted whenever it ends:
+// after the first game nothing in the simulation may allocate, including
+// multi-ball bursts, brick hits, lost lives and restarts.
+TEST_CASE("A running level does not allocate", "[simulation][allocations]")
+{
+    constexpr int TICKS{30000};
+
+    Simulation simulation;
+    SimulationInput input;
+    int tick = 0;
+    int restarts = 0;
+
+    auto playTick = [&]()
+    {
+        if (simulation.getState() != Simulation::PLAYING)
+        {
+            simulation.startGame();
+            ++restarts;
+        }
+
+        // Follow the first ball, relaunch after a lost life, burst every ten seconds
+        input.paddleTargetX = simulation.getBalls().empty() ? 0.f : simulation.getBalls().getPosition(0).x + 20.f;
+        input.launch = !simulation.isBallLaunched();
+        input.multiBall = (++tick % 1200 == 600) ? 3 : 0;
+        simulation.step(input);
+    };
+
+    // First game sizes every buffer
+    simulation.startGame();
+    while (simulation.getState() == Simulation::PLAYING)
+    {
+        playTick();
+    }
+
+    std::size_t before = bench::allocationCount();
+    for (int i = 0; i < TICKS; ++i)
+    {
+        playTick();
+    }
+    CHECK(bench::allocationCount() - before == 0);
+    // The measured ticks must include a restart, not only the tail of one game
+    CHECK(restarts > 0);
+}
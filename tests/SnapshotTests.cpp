@@ -0,0 +1,179 @@
+// Handoff of render snapshots from the simulation thread to the render thread,
+// over fixed step counts. Build with -DCASSEBRIQUES_SANITIZER=thread to also
+// catch data races between the two sides.
+#include "AllocationCounter.hpp"
+#include "BenchLayouts.hpp"
+#include "Catch.hpp"
+#include "RenderSnapshot.hpp"
+#include "Simulation.hpp"
+#include "SimulationThread.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace
+{
+// Steps a game with an AI paddle that follows the first ball; restarts it when it ends
+void stepFollowingBall(Simulation& simulation, const BrickField& layout)
+{
+    if (simulation.getState() != Simulation::PLAYING)
+    {
+        simulation.startGame(layout);
+    }
+
+    SimulationInput input;
+    const BallField& balls = simulation.getBalls();
+    input.paddleTargetX = balls.empty() ? Simulation::WINDOW_WIDTH / 2.f : balls.getPosition(0).x;
+    input.launch = !simulation.isBallLaunched();
+    input.multiBall = simulation.getTick() % 240 == 0 ? 2 : 0;
+    simulation.step(input);
+}
+
+// Whether the incrementally synced bricks match the simulation's
+bool bricksMatch(const BrickField& copy, const BrickField& source)
+{
+    if (copy.size() != source.size())
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < source.size(); ++i)
+    {
+        if (copy.isAlive(i) != source.isAlive(i) || copy.getHealth(i) != source.getHealth(i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Waits for the snapshot to show every posted command; false after a generous timeout
+bool waitUntilCurrent(SimulationThread& thread)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!thread.isCurrent(thread.acquireSnapshot()))
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+} // namespace
+
+// One capture per step of a running level: after the first few (which size
+// the snapshot) it must not allocate, and the synced bricks must stay exact.
+TEST_CASE("Snapshots copy a running level exactly without allocating", "[snapshot][allocations]")
+{
+    constexpr int STEPS{5000};
+    BrickField layout = bench::makeBrickLayout(1000, 3);
+    Simulation simulation;
+    RenderSnapshot snapshot;
+    for (int i = 0; i < 3; ++i)
+    {
+        stepFollowingBall(simulation, layout);
+        snapshot.capture(simulation, 0);
+    }
+
+    std::size_t allocations = 0;
+    for (int step = 0; step < STEPS; ++step)
+    {
+        std::uint32_t generation = simulation.getBricks().getGeneration();
+        stepFollowingBall(simulation, layout);
+        // A restart copies the whole field once, which allocates the first time
+        bool restarted = simulation.getBricks().getGeneration() != generation;
+
+        std::size_t before = bench::allocationCount();
+        snapshot.capture(simulation, step);
+        if (!restarted)
+        {
+            allocations += bench::allocationCount() - before;
+        }
+
+        if (snapshot.tick != simulation.getTick() || snapshot.score != simulation.getScore() ||
+            snapshot.balls.size() != simulation.getBalls().size() || !bricksMatch(snapshot.bricks, simulation.getBricks()))
+        {
+            FAIL("snapshot differs from the simulation after step " << step);
+        }
+    }
+    CHECK(allocations == 0);
+}
+
+// A producer steps and publishes a fixed number of snapshots as fast as it
+// can while the consumer acquires. Every acquired snapshot must be internally
+// consistent and never older than the one before it, and the last one must
+// arrive.
+TEST_CASE("The snapshot buffer hands over whole, ordered snapshots", "[snapshot]")
+{
+    constexpr std::int64_t PUBLISHED{20000};
+    BrickField layout = bench::makeBrickLayout(1000, 3);
+    Simulation simulation;
+    SnapshotBuffer buffer;
+
+    std::thread producer([&]()
+    {
+        for (std::int64_t tickEnd = 1; tickEnd <= PUBLISHED; ++tickEnd)
+        {
+            stepFollowingBall(simulation, layout);
+            buffer.beginWrite().capture(simulation, tickEnd);
+            buffer.publish();
+        }
+    });
+
+    std::int64_t lastTickEnd = 0;
+    std::int64_t outOfOrder = 0;
+    std::int64_t torn = 0;
+    while (lastTickEnd != PUBLISHED)
+    {
+        const RenderSnapshot& snapshot = buffer.acquire();
+        outOfOrder += snapshot.tickEndMicroseconds < lastTickEnd;
+        lastTickEnd = snapshot.tickEndMicroseconds;
+
+        // The whole snapshot comes from one step: the tick is set with the bricks
+        torn += snapshot.tickEndMicroseconds != 0 &&
+                (snapshot.bricks.size() != layout.size() || snapshot.balls.size() > Simulation::MAX_BALLS);
+        // Out of order would never reach the last tick; stop instead of spinning
+        if (outOfOrder != 0)
+        {
+            break;
+        }
+    }
+    producer.join();
+
+    CHECK(outOfOrder == 0);
+    CHECK(torn == 0);
+    CHECK(lastTickEnd == PUBLISHED);
+}
+
+// Commands posted to the simulation thread reach the next snapshot that is
+// current, in posting order, with the thread running at its real fixed rate
+TEST_CASE("Posted commands reach the snapshots", "[snapshot]")
+{
+    constexpr int ROUNDS{20};
+    BrickField layout = bench::makeBrickLayout(1000);
+    Simulation simulation;
+    SimulationThread thread(simulation, [&simulation](std::int64_t)
+    {
+        if (simulation.getState() == Simulation::PLAYING)
+        {
+            simulation.step(SimulationInput());
+        }
+    });
+    thread.start();
+
+    for (int round = 0; round < ROUNDS; ++round)
+    {
+        INFO("round " << round);
+        thread.post([&simulation, &layout]() { simulation.startGame(layout); });
+        REQUIRE(waitUntilCurrent(thread));
+        CHECK(thread.acquireSnapshot().state == Simulation::PLAYING);
+        CHECK(thread.acquireSnapshot().bricks.size() == layout.size());
+
+        thread.post([&simulation]() { simulation.returnToMenu(); });
+        REQUIRE(waitUntilCurrent(thread));
+        CHECK(thread.acquireSnapshot().state == Simulation::MENU);
+    }
+
+    thread.stop();
+}
@@ -0,0 +1,305 @@
+// Headless Monte-Carlo runner for level balancing: plays N games of one level
+// with an AI paddle, spread over every core, and prints the distributions of
+// completion time, paddle bounces and lives lost.
+//
+// Usage: CasseBriquesBatch [options]
+//   --games N         games to play (default 1000)
+//   --threads T       worker threads (default: one per hardware thread)
+//   --levels FILE     level pack to play instead of the default wall
+//   --level I         level of the pack (default 0)
+//   --ai track|random paddle AI (default random)
+//   --seed S          base seed; game i always plays with the same AI choices
+//   --speed X         ball speed multiplier (default 1)
+//   --deflection D    largest paddle rebound angle in degrees (default 60)
+//   --health H        give every brick H health instead of the level's
+//   --max-seconds S   stop a game after S simulated seconds (default 600)
+//
+// Every game owns its Simulation and writes only its own result slot, so the
+// runs share nothing and scale with the number of cores.
+#include "LevelPack.hpp"
+#include "Simulation.hpp"
+#include "TaskPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+enum class Ai
+{
+    Track,  // Scripted: aims the rebound by a fixed cycle of offsets
+    Random, // Aims at a random point of the paddle, sometimes missing
+};
+
+struct Options
+{
+    long games{1000};
+    unsigned int threads{0};
+    std::string levelsPath;
+    long level{0};
+    Ai ai{Ai::Random};
+    std::uint32_t seed{1};
+    float speed{1.f};
+    float deflection{Simulation::PADDLE_DEFLECTION_DEGREES};
+    int health{0};
+    double maxSeconds{600.0};
+};
+
+enum class Outcome
+{
+    Victory,
+    GameOver,
+    Timeout
+};
+
+struct GameResult
+{
+    Outcome outcome{Outcome::Timeout};
+    std::uint64_t ticks{0};
+    int bounces{0};
+    int livesLost{0};
+};
+
+// Ball the paddle should catch next: the lowest one coming down, or the lowest at all
+float nextBallX(const BallField& balls)
+{
+    std::size_t best = 0;
+    bool bestFalling = false;
+    for (std::size_t i = 0; i < balls.size(); ++i)
+    {
+        bool falling = balls.getVelocity(i).y > 0.f;
+        if (i == 0 || (falling && !bestFalling) ||
+            (falling == bestFalling && balls.getPosition(i).y > balls.getPosition(best).y))
+        {
+            best = i;
+            bestFalling = falling;
+        }
+    }
+    return balls.getPosition(best).x + balls.getRadius();
+}
+
+GameResult playGame(const Options& options, const BrickField& layout, long game)
+{
+    Simulation simulation;
+    simulation.setBallSpeedMultiplier(options.speed);
+    simulation.setPaddleDeflection(options.deflection);
+    simulation.startGame(layout);
+
+    GameResult result;
+    simulation.getEvents().subscribe<LifeLostEvent>(
+        [](void* context, const LifeLostEvent&) { ++static_cast<GameResult*>(context)->livesLost; }, &result);
+
+    // Seeded per game, so results do not depend on the thread count
+    std::seed_seq seed{options.seed, static_cast<std::uint32_t>(game)};
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> randomOffset(-0.6f * Simulation::PADDLE_WIDTH, 0.6f * Simulation::PADDLE_WIDTH);
+    const float scriptedOffsets[] = {-30.f, 10.f, 35.f, -10.f, 0.f, 20.f, -40.f};
+
+    // A new aim is picked after every rebound (and for every launch)
+    float aim = 0.f;
+    int aimedBounce = -1;
+
+    std::uint64_t maxTicks = static_cast<std::uint64_t>(options.maxSeconds * Simulation::STEPS_PER_SECOND);
+    SimulationInput input;
+    while (simulation.getState() == Simulation::PLAYING && simulation.getTick() < maxTicks)
+    {
+        if (simulation.getPaddleBounces() != aimedBounce)
+        {
+            aimedBounce = simulation.getPaddleBounces();
+            aim = options.ai == Ai::Random ? randomOffset(random)
+                                           : scriptedOffsets[aimedBounce % (sizeof(scriptedOffsets) / sizeof(float))];
+        }
+
+        const BallField& balls = simulation.getBalls();
+        input.paddleTargetX = balls.empty() ? Simulation::WINDOW_WIDTH / 2.f : nextBallX(balls) - aim;
+        input.launch = !simulation.isBallLaunched();
+        simulation.step(input);
+    }
+
+    result.outcome = simulation.getState() == Simulation::VICTORY     ? Outcome::Victory
+                     : simulation.getState() == Simulation::GAME_OVER ? Outcome::GameOver
+                                                                      : Outcome::Timeout;
+    result.ticks = simulation.getTick();
+    result.bounces = simulation.getPaddleBounces();
+    return result;
+}
+
+// min / p10 / median / p90 / max / mean of one column
+void printDistribution(const char* name, std::vector<double> values)
+{
+    if (values.empty())
+    {
+        std::printf("%-12s %8s\n", name, "-");
+        return;
+    }
+
+    std::sort(values.begin(), values.end());
+    auto percentile = [&values](double p)
+    {
+        return values[static_cast<std::size_t>(p * static_cast<double>(values.size() - 1) + 0.5)];
+    };
+    double sum = 0.0;
+    for (double value : values)
+    {
+        sum += value;
+    }
+    std::printf("%-12s %8.1f %8.1f %8.1f %8.1f %8.1f %8.1f\n", name, values.front(), percentile(0.1),
+                percentile(0.5), percentile(0.9), values.back(), sum / static_cast<double>(values.size()));
+}
+
+bool parseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; i += 2)
+    {
+        std::string option = argv[i];
+        if (i + 1 >= argc)
+        {
+            return false;
+        }
+        const char* value = argv[i + 1];
+
+        if (option == "--games")
+        {
+            options.games = std::max(1L, std::strtol(value, nullptr, 10));
+        }
+        else if (option == "--threads")
+        {
+            options.threads = static_cast<unsigned int>(std::max(0L, std::strtol(value, nullptr, 10)));
+        }
+        else if (option == "--levels")
+        {
+            options.levelsPath = value;
+        }
+        else if (option == "--level")
+        {
+            options.level = std::max(0L, std::strtol(value, nullptr, 10));
+        }
+        else if (option == "--ai")
+        {
+            std::string ai = value;
+            if (ai != "track" && ai != "random")
+            {
+                return false;
+            }
+            options.ai = ai == "track" ? Ai::Track : Ai::Random;
+        }
+        else if (option == "--seed")
+        {
+            options.seed = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 10));
+        }
+        else if (option == "--speed")
+        {
+            options.speed = std::strtof(value, nullptr);
+        }
+        else if (option == "--deflection")
+        {
+            options.deflection = std::strtof(value, nullptr);
+        }
+        else if (option == "--health")
+        {
+            options.health = static_cast<int>(std::max(0L, std::strtol(value, nullptr, 10)));
+        }
+        else if (option == "--max-seconds")
+        {
+            options.maxSeconds = std::strtod(value, nullptr);
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        std::printf("Usage: CasseBriquesBatch [--games N] [--threads T] [--levels FILE] [--level I]\n"
+                    "                         [--ai track|random] [--seed S] [--speed X] [--deflection D]\n"
+                    "                         [--health H] [--max-seconds S]\n");
+        return 1;
+    }
+
+    // Every game copies its bricks from this layout, which is only ever read
+    BrickField level;
+    {
+        Simulation source;
+        LevelPack pack;
+        if (options.levelsPath.empty())
+        {
+            source.startGame();
+        }
+        else if (pack.open(options.levelsPath) && static_cast<std::size_t>(options.level) < pack.getLevelCount())
+        {
+            source.startGame(pack.getLevel(static_cast<std::size_t>(options.level)));
+        }
+        else
+        {
+            std::printf("Error: %s has no level %ld\n", options.levelsPath.c_str(), options.level);
+            return 1;
+        }
+
+        const BrickField& bricks = source.getBricks();
+        level.reserve(bricks.size());
+        for (std::size_t i = 0; i < bricks.size(); ++i)
+        {
+            sf::FloatRect aabb = bricks.getAABB(i);
+            level.add(aabb.left, aabb.top, aabb.width, aabb.height,
+                      options.health > 0 ? options.health : bricks.getMaxHealth(i));
+        }
+    }
+
+    std::vector<GameResult> results(static_cast<std::size_t>(options.games));
+    auto start = std::chrono::steady_clock::now();
+    unsigned int threads;
+    {
+        TaskPool pool(options.threads);
+        threads = pool.getThreadCount();
+        for (long game = 0; game < options.games; ++game)
+        {
+            pool.submit([&options, &level, &results, game]()
+            {
+                results[static_cast<std::size_t>(game)] = playGame(options, level, game);
+            });
+        }
+        pool.wait();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    long outcomes[3] = {0, 0, 0};
+    std::uint64_t totalTicks = 0;
+    std::vector<double> victoryTimes;
+    std::vector<double> bounces;
+    std::vector<double> livesLost;
+    for (const GameResult& result : results)
+    {
+        ++outcomes[static_cast<int>(result.outcome)];
+        totalTicks += result.ticks;
+        if (result.outcome == Outcome::Victory)
+        {
+            victoryTimes.push_back(static_cast<double>(result.ticks) / Simulation::STEPS_PER_SECOND);
+        }
+        bounces.push_back(result.bounces);
+        livesLost.push_back(result.livesLost);
+    }
+
+    double games = static_cast<double>(options.games);
+    std::printf("games:    %ld on %u threads in %.2f s (%.0f games/s, %.0f ticks/s)\n", options.games, threads,
+                seconds, games / seconds, static_cast<double>(totalTicks) / seconds);
+    std::printf("outcome:  victory %ld (%.1f%%), game over %ld (%.1f%%), timeout %ld (%.1f%%)\n", outcomes[0],
+                100.0 * outcomes[0] / games, outcomes[1], 100.0 * outcomes[1] / games, outcomes[2],
+                100.0 * outcomes[2] / games);
+    std::printf("\n%-12s %8s %8s %8s %8s %8s %8s\n", "", "min", "p10", "median", "p90", "max", "mean");
+    printDistribution("clear (s)", victoryTimes);
+    printDistribution("bounces", bounces);
+    printDistribution("lives lost", livesLost);
+    return 0;
+}
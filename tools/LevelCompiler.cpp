@@ -0,0 +1,49 @@
+// Compiles the text level format into a binary level pack.
+//
+// Usage: CasseBriquesLevelCompiler <levels.txt> <pack.cblv>
+#include "LevelPack.hpp"
+#include <cstdio>
+#include <fstream>
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3)
+    {
+        std::printf("Usage: CasseBriquesLevelCompiler <levels.txt> <pack.cblv>\n");
+        return 1;
+    }
+
+    std::ifstream input(argv[1]);
+    if (!input)
+    {
+        std::printf("Error: could not open %s\n", argv[1]);
+        return 1;
+    }
+
+    std::vector<std::uint8_t> pack;
+    std::string error;
+    if (!compileLevelText(input, pack, error))
+    {
+        std::printf("%s: %s\n", argv[1], error.c_str());
+        return 1;
+    }
+
+    std::ofstream output(argv[2], std::ios::binary);
+    output.write(reinterpret_cast<const char*>(pack.data()), static_cast<std::streamsize>(pack.size()));
+    output.close();
+    if (!output)
+    {
+        std::printf("Error: could not write %s\n", argv[2]);
+        return 1;
+    }
+
+    // Read it back through the loader so a bad pack never ships
+    LevelPack check;
+    if (!check.open(argv[2]))
+    {
+        std::printf("Error: %s failed validation\n", argv[2]);
+        return 1;
+    }
+    std::printf("%s: %zu levels, %zu bytes\n", argv[2], check.getLevelCount(), pack.size());
+    return 0;
+}
@@ -0,0 +1,459 @@
+// Offscreen render regression check: draws one frame of every game state into
+// an sf::RenderTexture, exactly as the window would, and compares it with a
+// golden PNG within a tolerance. Also times each state's frame, so renderer
+// changes can be checked for both correctness and speed. Needs an OpenGL
+// context but no GPU: Mesa's llvmpipe under a virtual X server is enough.
+//
+// Usage: CasseBriquesRenderCheck [options]
+//   --golden DIR      golden images, one <STATE>.png per state (default assets/golden)
+//   --update          write the rendered frames as the new goldens instead of comparing
+//                     (a missing golden is always written: the first run creates them)
+//   --out DIR         where failing frames and their diffs are written (default .)
+//   --font FILE       HUD font (default: the system fonts the game looks for)
+//   --images DIR      sprite images (default assets/images)
+//   --tolerance T     per-channel difference a pixel may have and still match (default 16)
+//   --max-diff PCT    percentage of pixels allowed to differ (default 0.1)
+//   --runs N          timed frames per state (default 100)
+//   --csv FILE        write the per-state timings to FILE
+//   --seed S          seed of the paddle AI that plays into each state (default 1)
+//
+// Exit status: 0 if every state matches or had its golden created, 2 if one does not
+// match, 1 on error. Goldens depend on the font and the rasteriser, so none are
+// shipped: each setup records its own on the first run and compares against them after.
+#include "FrameRenderer.hpp"
+#include "RenderSnapshot.hpp"
+#include "Simulation.hpp"
+#include "TextureAtlas.hpp"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct Options
+{
+    std::string goldenDir{std::string(CASSEBRIQUES_ASSET_DIR) + "/golden"};
+    bool update{false};
+    std::string outDir{"."};
+    std::string fontPath;
+    std::string imageDir{std::string(CASSEBRIQUES_ASSET_DIR) + "/images"};
+    int tolerance{16};
+    double maxDiffPercent{0.1};
+    long runs{100};
+    std::string csvPath;
+    std::uint32_t seed{1};
+};
+
+const Simulation::GameState STATES[] = {Simulation::MENU, Simulation::PLAYING, Simulation::GAME_OVER,
+                                        Simulation::VICTORY};
+
+// Same candidates as the game
+const char* const FONT_PATHS[] = {"/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
+                                  "/usr/share/fonts/truetype/liberation/LiberationSans-Regular.ttf",
+                                  "/System/Library/Fonts/Arial.ttf"};
+
+// Give up on reaching a state after this much simulated time
+constexpr std::uint64_t MAX_TICKS{600 * Simulation::STEPS_PER_SECOND};
+
+const char* stateName(Simulation::GameState state)
+{
+    switch (state)
+    {
+    case Simulation::MENU:
+        return "MENU";
+    case Simulation::PLAYING:
+        return "PLAYING";
+    case Simulation::GAME_OVER:
+        return "GAME_OVER";
+    case Simulation::VICTORY:
+        return "VICTORY";
+    }
+    return "?";
+}
+
+// Play from a fresh game into `state` with a scripted paddle. The simulation
+// is deterministic, so the same seed always gives the same frame. False if
+// the state was not reached.
+bool playInto(Simulation& simulation, Simulation::GameState state, std::uint32_t seed)
+{
+    if (state == Simulation::MENU)
+    {
+        return true;
+    }
+
+    // Victory on a short row of bricks; the other states on the default wall
+    if (state == Simulation::VICTORY)
+    {
+        BrickField layout;
+        for (int col = 3; col < 7; ++col)
+        {
+            layout.add(static_cast<float>(col) * (Simulation::BRICK_WIDTH + Simulation::BRICK_SPACING) + 30.f, 80.f,
+                       Simulation::BRICK_WIDTH, Simulation::BRICK_HEIGHT, 1);
+        }
+        simulation.startGame(layout);
+    }
+    else
+    {
+        simulation.startGame();
+    }
+
+    // PLAYING: a second and a half in, ball in flight. GAME_OVER: the paddle
+    // runs away from the ball. VICTORY: a new random aim after every rebound.
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> randomOffset(-0.4f * Simulation::PADDLE_WIDTH,
+                                                       0.4f * Simulation::PADDLE_WIDTH);
+    float aim = 0.f;
+    int aimedBounce = -1;
+    SimulationInput input;
+    while (simulation.getState() == Simulation::PLAYING && simulation.getTick() < MAX_TICKS)
+    {
+        if (state == Simulation::PLAYING && simulation.getTick() == 180)
+        {
+            return true;
+        }
+        if (simulation.getPaddleBounces() != aimedBounce)
+        {
+            aimedBounce = simulation.getPaddleBounces();
+            aim = randomOffset(random);
+        }
+
+        const BallField& balls = simulation.getBalls();
+        float ballX = balls.empty() ? Simulation::WINDOW_WIDTH / 2.f : balls.getPosition(0).x + balls.getRadius();
+        if (state == Simulation::GAME_OVER)
+        {
+            input.paddleTargetX = ballX < Simulation::WINDOW_WIDTH / 2.f ? static_cast<float>(Simulation::WINDOW_WIDTH)
+                                                                         : 0.f;
+        }
+        else
+        {
+            input.paddleTargetX = ballX - aim;
+        }
+        input.launch = !simulation.isBallLaunched();
+        simulation.step(input);
+    }
+    return simulation.getState() == state;
+}
+
+struct Comparison
+{
+    bool sameSize{false};
+    std::size_t differing{0}; // Pixels with a channel off by more than the tolerance
+    int maxDelta{0};
+};
+
+// Differing pixels are painted red in `diff`, the others a dimmed copy of the golden
+Comparison compareImages(const sf::Image& actual, const sf::Image& golden, int tolerance, sf::Image& diff)
+{
+    Comparison result;
+    sf::Vector2u size = actual.getSize();
+    result.sameSize = size == golden.getSize();
+    if (!result.sameSize)
+    {
+        return result;
+    }
+
+    diff.create(size.x, size.y, sf::Color::Black);
+    const sf::Uint8* a = actual.getPixelsPtr();
+    const sf::Uint8* b = golden.getPixelsPtr();
+    for (unsigned int y = 0; y < size.y; ++y)
+    {
+        for (unsigned int x = 0; x < size.x; ++x)
+        {
+            std::size_t offset = (static_cast<std::size_t>(y) * size.x + x) * 4;
+            int delta = 0;
+            for (std::size_t channel = 0; channel < 4; ++channel)
+            {
+                delta = std::max(delta, std::abs(static_cast<int>(a[offset + channel]) - b[offset + channel]));
+            }
+            result.maxDelta = std::max(result.maxDelta, delta);
+            if (delta > tolerance)
+            {
+                ++result.differing;
+                diff.setPixel(x, y, sf::Color::Red);
+            }
+            else
+            {
+                diff.setPixel(x, y, sf::Color(b[offset] / 4, b[offset + 1] / 4, b[offset + 2] / 4));
+            }
+        }
+    }
+    return result;
+}
+
+struct Timing
+{
+    double minDraw{0.0}; // Microseconds to draw and display a frame
+    double medianDraw{0.0};
+    double minTotal{0.0}; // Same, plus reading the pixels back
+    double medianTotal{0.0};
+};
+
+double median(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+// Draw the snapshot `runs` times; the rasteriser only has to finish when the
+// pixels are read back, so both points are timed
+Timing timeFrames(FrameRenderer& frame, sf::RenderTexture& texture, const RenderSnapshot& snapshot, long runs,
+                  sf::Image& image)
+{
+    std::vector<double> draw;
+    std::vector<double> total;
+    for (long run = 0; run < runs; ++run)
+    {
+        auto start = std::chrono::steady_clock::now();
+        frame.draw(texture, snapshot, 1.f);
+        texture.display();
+        auto drawn = std::chrono::steady_clock::now();
+        image = texture.getTexture().copyToImage();
+        auto read = std::chrono::steady_clock::now();
+        draw.push_back(std::chrono::duration<double, std::micro>(drawn - start).count());
+        total.push_back(std::chrono::duration<double, std::micro>(read - start).count());
+    }
+
+    Timing timing;
+    timing.minDraw = *std::min_element(draw.begin(), draw.end());
+    timing.medianDraw = median(draw);
+    timing.minTotal = *std::min_element(total.begin(), total.end());
+    timing.medianTotal = median(total);
+    return timing;
+}
+
+bool fileExists(const std::string& path)
+{
+    return std::ifstream(path).good();
+}
+
+bool parseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string option = argv[i];
+        if (option == "--update")
+        {
+            options.update = true;
+            continue;
+        }
+        if (i + 1 >= argc)
+        {
+            return false;
+        }
+        const char* value = argv[++i];
+
+        if (option == "--golden")
+        {
+            options.goldenDir = value;
+        }
+        else if (option == "--out")
+        {
+            options.outDir = value;
+        }
+        else if (option == "--font")
+        {
+            options.fontPath = value;
+        }
+        else if (option == "--images")
+        {
+            options.imageDir = value;
+        }
+        else if (option == "--tolerance")
+        {
+            options.tolerance = static_cast<int>(std::max(0L, std::strtol(value, nullptr, 10)));
+        }
+        else if (option == "--max-diff")
+        {
+            options.maxDiffPercent = std::max(0.0, std::strtod(value, nullptr));
+        }
+        else if (option == "--runs")
+        {
+            options.runs = std::max(1L, std::strtol(value, nullptr, 10));
+        }
+        else if (option == "--csv")
+        {
+            options.csvPath = value;
+        }
+        else if (option == "--seed")
+        {
+            options.seed = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 10));
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        std::printf("Usage: CasseBriquesRenderCheck [--golden DIR] [--update] [--out DIR] [--font FILE]\n"
+                    "                               [--images DIR] [--tolerance T] [--max-diff PCT] [--runs N]\n"
+                    "                               [--csv FILE] [--seed S]\n");
+        return 1;
+    }
+
+    // Without a font the HUD draws nothing, which would make the goldens useless
+    sf::Font font;
+    bool fontLoaded = false;
+    if (!options.fontPath.empty())
+    {
+        fontLoaded = font.loadFromFile(options.fontPath);
+    }
+    else
+    {
+        for (const char* path : FONT_PATHS)
+        {
+            if (font.loadFromFile(path))
+            {
+                fontLoaded = true;
+                break;
+            }
+        }
+    }
+    if (!fontLoaded)
+    {
+        std::printf("Error: could not load a font (use --font)\n");
+        return 1;
+    }
+
+    sf::RenderTexture texture;
+    if (!texture.create(Simulation::WINDOW_WIDTH, Simulation::WINDOW_HEIGHT))
+    {
+        std::printf("Error: could not create a %ux%u render texture (no OpenGL context?)\n", Simulation::WINDOW_WIDTH,
+                    Simulation::WINDOW_HEIGHT);
+        return 1;
+    }
+
+    // Loaded synchronously here; the game does the same on its loader thread
+    sf::Image ball, brick, paddle;
+    TextureAtlas atlas;
+    sf::Texture atlasTexture;
+    if (!ball.loadFromFile(options.imageDir + "/ball.png") || !brick.loadFromFile(options.imageDir + "/brick.png") ||
+        !paddle.loadFromFile(options.imageDir + "/paddle.png") || !atlas.build(ball, brick, paddle) ||
+        !atlasTexture.loadFromImage(atlas.getImage()))
+    {
+        std::printf("Error: could not load the sprites from %s\n", options.imageDir.c_str());
+        return 1;
+    }
+    atlasTexture.setSmooth(true);
+
+    std::FILE* csv = nullptr;
+    if (!options.csvPath.empty())
+    {
+        csv = std::fopen(options.csvPath.c_str(), "w");
+        if (!csv)
+        {
+            std::printf("Error: could not write %s\n", options.csvPath.c_str());
+            return 1;
+        }
+        std::fprintf(csv, "state,runs,min_draw_us,median_draw_us,min_total_us,median_total_us\n");
+    }
+
+    std::printf("Frame times in microseconds over %ld runs, without and with the readback\n", options.runs);
+    std::printf("%-10s %10s %10s %10s %10s   %s\n", "state", "draw min", "median", "+read min", "median", "golden");
+    bool allMatch = true;
+    int created = 0;
+    bool writeFailed = false;
+    for (Simulation::GameState state : STATES)
+    {
+        Simulation simulation;
+        if (!playInto(simulation, state, options.seed))
+        {
+            std::printf("Error: the scripted game did not reach %s\n", stateName(state));
+            return 1;
+        }
+        RenderSnapshot snapshot;
+        snapshot.capture(simulation, 0);
+
+        // A renderer per state, so every frame starts from the same renderer state
+        FrameRenderer frame;
+        frame.setFont(font);
+        frame.setAtlas(atlasTexture, atlas);
+        sf::Image image;
+        Timing timing = timeFrames(frame, texture, snapshot, options.runs, image);
+        if (csv)
+        {
+            std::fprintf(csv, "%s,%ld,%.1f,%.1f,%.1f,%.1f\n", stateName(state), options.runs, timing.minDraw,
+                         timing.medianDraw, timing.minTotal, timing.medianTotal);
+        }
+
+        std::string goldenPath = options.goldenDir + "/" + stateName(state) + ".png";
+        std::string verdict;
+        if (options.update || !fileExists(goldenPath))
+        {
+            // Nothing to compare against yet: this frame becomes the golden
+            bool written = image.saveToFile(goldenPath);
+            verdict = written ? (options.update ? "written" : "created " + goldenPath) : "could not write " + goldenPath;
+            writeFailed = writeFailed || !written;
+            created += written && !options.update;
+        }
+        else
+        {
+            sf::Image golden;
+            sf::Image diff;
+            Comparison comparison;
+            if (golden.loadFromFile(goldenPath))
+            {
+                comparison = compareImages(image, golden, options.tolerance, diff);
+            }
+
+            std::size_t pixels = static_cast<std::size_t>(image.getSize().x) * image.getSize().y;
+            double percent = 100.0 * static_cast<double>(comparison.differing) / static_cast<double>(pixels);
+            bool match = comparison.sameSize && percent <= options.maxDiffPercent;
+            char line[96];
+            if (!comparison.sameSize)
+            {
+                std::snprintf(line, sizeof(line), "FAIL: unreadable or wrong size");
+            }
+            else
+            {
+                std::snprintf(line, sizeof(line), "%s: %.3f%% of pixels differ, max delta %d",
+                              match ? "ok" : "FAIL", percent, comparison.maxDelta);
+            }
+            verdict = line;
+
+            if (!match)
+            {
+                allMatch = false;
+                std::string prefix = options.outDir + "/" + stateName(state);
+                image.saveToFile(prefix + "-actual.png");
+                if (comparison.sameSize)
+                {
+                    diff.saveToFile(prefix + "-diff.png");
+                }
+            }
+        }
+
+        std::printf("%-10s %10.1f %10.1f %10.1f %10.1f   %s\n", stateName(state), timing.minDraw, timing.medianDraw,
+                    timing.minTotal, timing.medianTotal, verdict.c_str());
+    }
+
+    if (csv)
+    {
+        std::fclose(csv);
+    }
+    if (created > 0)
+    {
+        std::printf("%d golden(s) created from this run; check them once, later runs compare against them\n",
+                    created);
+    }
+    if (writeFailed)
+    {
+        return 1;
+    }
+    return allMatch ? 0 : 2;
+}
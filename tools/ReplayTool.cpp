@@ -0,0 +1,144 @@
+// Headless replay runner: plays a recorded input log as fast as possible,
+// then prints the final state and its hash (compare hashes to spot desyncs).
+//
+// Usage: CasseBriquesReplay <replay file> [--repeat N] [--trace K]
+//   --repeat N  play the log N times and check every run ends on the same hash
+//   --trace K   print the state hash every K ticks, to bisect where two builds diverge
+// Exits with 2 on an unknown or incomplete option, or when repeated runs desync.
+#include "Replay.hpp"
+#include "Simulation.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace
+{
+const char* stateName(Simulation::GameState state)
+{
+    switch (state)
+    {
+    case Simulation::MENU:
+        return "MENU";
+    case Simulation::PLAYING:
+        return "PLAYING";
+    case Simulation::GAME_OVER:
+        return "GAME_OVER";
+    case Simulation::VICTORY:
+        return "VICTORY";
+    }
+    return "?";
+}
+
+// Whole non-negative number, nothing else
+bool parseCount(const char* text, long& value)
+{
+    char* end = nullptr;
+    value = std::strtol(text, &end, 10);
+    return end != text && *end == '\0' && value >= 0;
+}
+
+std::uint64_t playOnce(ReplayPlayer& player, Simulation& simulation, long trace)
+{
+    player.begin(simulation);
+
+    SimulationInput input;
+    while (player.next(input))
+    {
+        simulation.step(input);
+        if (trace > 0 && simulation.getTick() % static_cast<std::uint64_t>(trace) == 0)
+        {
+            std::printf("tick %llu hash %016llx\n", static_cast<unsigned long long>(simulation.getTick()),
+                        static_cast<unsigned long long>(simulation.computeStateHash()));
+        }
+    }
+    return simulation.computeStateHash();
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const char* usage = "Usage: CasseBriquesReplay <replay file> [--repeat N] [--trace K]\n";
+    if (argc < 2)
+    {
+        std::printf("%s", usage);
+        return 1;
+    }
+
+    long repeat = 1;
+    long trace = 0;
+    for (int i = 2; i < argc; i += 2)
+    {
+        std::string option = argv[i];
+        if (i + 1 == argc)
+        {
+            std::printf("Error: %s needs a value\n%s", option.c_str(), usage);
+            return 2;
+        }
+        long value = 0;
+        if (!parseCount(argv[i + 1], value))
+        {
+            std::printf("Error: %s needs a whole number, got %s\n%s", option.c_str(), argv[i + 1], usage);
+            return 2;
+        }
+        if (option == "--repeat")
+        {
+            repeat = std::max(1L, value);
+        }
+        else if (option == "--trace")
+        {
+            trace = value;
+        }
+        else
+        {
+            std::printf("Error: unknown option %s\n%s", option.c_str(), usage);
+            return 2;
+        }
+    }
+
+    ReplayPlayer player;
+    if (!player.loadFromFile(argv[1]))
+    {
+        std::printf("Error: %s is not a valid replay\n", argv[1]);
+        return 1;
+    }
+    if (player.getStepsPerSecond() != Simulation::STEPS_PER_SECOND)
+    {
+        std::printf("Warning: replay recorded at %d steps/s, simulation runs at %d\n",
+                    player.getStepsPerSecond(), Simulation::STEPS_PER_SECOND);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::uint64_t firstHash = 0;
+    bool deterministic = true;
+    Simulation simulation;
+    for (long run = 0; run < repeat; ++run)
+    {
+        std::uint64_t hash = playOnce(player, simulation, run == 0 ? trace : 0);
+        if (run == 0)
+        {
+            firstHash = hash;
+        }
+        else if (hash != firstHash)
+        {
+            deterministic = false;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double ticks = static_cast<double>(player.getTickCount()) * static_cast<double>(repeat);
+    double realTime = ticks / Simulation::STEPS_PER_SECOND;
+    std::printf("ticks:   %zu\n", player.getTickCount());
+    std::printf("state:   %s, score %d, lives %d\n", stateName(simulation.getState()),
+                simulation.getScore(), simulation.getLives());
+    std::printf("hash:    %016llx\n", static_cast<unsigned long long>(firstHash));
+    std::printf("speed:   %.0f ticks/s (%.0fx real time)\n", ticks / seconds, realTime / seconds);
+    if (!deterministic)
+    {
+        std::printf("DESYNC: repeated runs ended on different hashes\n");
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,303 @@
+// Headless versus peer: plays one side of a match over UDP with an AI paddle,
+// for testing rollback over loopback or a real network. Start one peer per
+// player, then compare the final hashes they print.
+//
+// Usage: CasseBriquesVersus [options]
+//   --player P      0 or 1 (default 0)
+//   --peer HOST     address of the other peer (default 127.0.0.1)
+//   --port N        local UDP port (default UdpLink::DEFAULT_PORT + player)
+//   --peer-port N   remote UDP port (default UdpLink::DEFAULT_PORT + other player)
+//   --latency MS    added one-way latency of outgoing packets (default 0)
+//   --jitter MS     added random delay on top, up to MS (default 0)
+//   --loss PCT      percentage of outgoing packets dropped (default 0)
+//   --seconds S     end the match after S simulated seconds (default 60)
+//   --seed S        seed of the AI aims and of the injected delays and losses
+//
+// The peers run in real time at Simulation::STEPS_PER_SECOND. Both must use
+// the same --seconds; a match ends earlier once a player clears the level or
+// both are out of lives.
+#include "InputQueue.hpp"
+#include "UdpLink.hpp"
+#include "VersusSession.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+
+namespace
+{
+struct Options
+{
+    int player{0};
+    std::string peer{"127.0.0.1"};
+    long port{-1};
+    long peerPort{-1};
+    double latency{0.0};
+    double jitter{0.0};
+    double loss{0.0};
+    double seconds{60.0};
+    std::uint32_t seed{1};
+};
+
+// Give up on a peer that has sent nothing for this long
+constexpr std::int64_t PEER_TIMEOUT_MICROSECONDS{5000000};
+// Keep sending after the end, so the peer gets our last inputs and acknowledgements
+constexpr std::int64_t LINGER_MICROSECONDS{500000};
+
+bool parseOptions(int argc, char* argv[], Options& options)
+{
+    for (int i = 1; i < argc; i += 2)
+    {
+        std::string option = argv[i];
+        if (i + 1 >= argc)
+        {
+            return false;
+        }
+        const char* value = argv[i + 1];
+
+        if (option == "--player")
+        {
+            options.player = static_cast<int>(std::strtol(value, nullptr, 10));
+            if (options.player != 0 && options.player != 1)
+            {
+                return false;
+            }
+        }
+        else if (option == "--peer")
+        {
+            options.peer = value;
+        }
+        else if (option == "--port")
+        {
+            options.port = std::strtol(value, nullptr, 10);
+        }
+        else if (option == "--peer-port")
+        {
+            options.peerPort = std::strtol(value, nullptr, 10);
+        }
+        else if (option == "--latency")
+        {
+            options.latency = std::max(0.0, std::strtod(value, nullptr));
+        }
+        else if (option == "--jitter")
+        {
+            options.jitter = std::max(0.0, std::strtod(value, nullptr));
+        }
+        else if (option == "--loss")
+        {
+            options.loss = std::min(100.0, std::max(0.0, std::strtod(value, nullptr)));
+        }
+        else if (option == "--seconds")
+        {
+            options.seconds = std::strtod(value, nullptr);
+        }
+        else if (option == "--seed")
+        {
+            options.seed = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 10));
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Paddle under the lowest ball, aimed a little off-centre, with a new aim
+// after every rebound; relaunch after a lost life
+class PaddleAi
+{
+public:
+    explicit PaddleAi(std::uint32_t seed)
+        : m_random(seed)
+    {
+    }
+
+    SimulationInput next(const Simulation& field)
+    {
+        if (field.getPaddleBounces() != m_aimedBounce)
+        {
+            std::uniform_real_distribution<float> offset(-0.4f * Simulation::PADDLE_WIDTH,
+                                                         0.4f * Simulation::PADDLE_WIDTH);
+            m_aimedBounce = field.getPaddleBounces();
+            m_aim = offset(m_random);
+        }
+
+        SimulationInput input;
+        const BallField& balls = field.getBalls();
+        std::size_t lowest = 0;
+        for (std::size_t i = 1; i < balls.size(); ++i)
+        {
+            if (balls.getPosition(i).y > balls.getPosition(lowest).y)
+            {
+                lowest = i;
+            }
+        }
+        input.paddleTargetX = balls.empty() ? Simulation::WINDOW_WIDTH / 2.f
+                                            : balls.getPosition(lowest).x + balls.getRadius() - m_aim;
+        input.launch = !field.isBallLaunched();
+        return input;
+    }
+
+private:
+    std::mt19937 m_random;
+    float m_aim{0.f};
+    int m_aimedBounce{-1};
+};
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!parseOptions(argc, argv, options))
+    {
+        std::printf("Usage: CasseBriquesVersus [--player 0|1] [--peer HOST] [--port N] [--peer-port N]\n"
+                    "                          [--latency MS] [--jitter MS] [--loss PCT] [--seconds S] [--seed S]\n");
+        return 1;
+    }
+
+    unsigned short port = static_cast<unsigned short>(
+        options.port >= 0 ? options.port : UdpLink::DEFAULT_PORT + options.player);
+    unsigned short peerPort = static_cast<unsigned short>(
+        options.peerPort >= 0 ? options.peerPort : UdpLink::DEFAULT_PORT + 1 - options.player);
+    UdpLink link;
+    if (!link.open(port, sf::IpAddress(options.peer), peerPort))
+    {
+        std::printf("Error: could not bind UDP port %u\n", port);
+        return 1;
+    }
+    LinkConditioner::Conditions conditions;
+    conditions.latencyMilliseconds = options.latency;
+    conditions.jitterMilliseconds = options.jitter;
+    conditions.lossRate = options.loss / 100.0;
+    conditions.seed = options.seed * 2 + static_cast<std::uint32_t>(options.player);
+    link.setConditions(conditions);
+
+    std::array<Simulation, 2> fields;
+    VersusSession session(fields[0], fields[1], options.player);
+    session.start();
+    PaddleAi ai(options.seed * 2 + static_cast<std::uint32_t>(options.player));
+    const Simulation& localField = fields[static_cast<std::size_t>(options.player)];
+
+    std::printf("player %d on port %u, peer %s:%u, latency %.0f ms, jitter %.0f ms, loss %.1f%%\n", options.player,
+                port, options.peer.c_str(), peerPort, options.latency, options.jitter, options.loss);
+
+    std::uint64_t maxTicks = static_cast<std::uint64_t>(options.seconds * Simulation::STEPS_PER_SECOND);
+    std::array<unsigned char, VersusSession::MAX_PACKET_SIZE> packet;
+    std::size_t size = 0;
+    std::uint64_t stalledTicks = 0;
+    std::uint64_t frames = 0;
+    std::uint64_t worstFrameResimulations = 0;
+
+    std::int64_t start = InputQueue::now();
+    std::int64_t lastHeard = start;
+    std::int64_t lastSent = start;
+    std::int64_t endedAt = -1;
+    bool timedOut = false;
+    while (true)
+    {
+        std::int64_t now = InputQueue::now();
+        link.update();
+        while (link.receive(packet.data(), packet.size(), size))
+        {
+            if (session.readPacket(packet.data(), size))
+            {
+                lastHeard = now;
+            }
+        }
+
+        std::uint64_t resimulatedBefore = session.getStats().resimulatedTicks;
+        session.settle();
+        bool over = (session.isFinished() || session.getTick() >= maxTicks) && session.isSettled();
+
+        // Ticks due by the wall clock; a tick the session refuses waits for the peer
+        std::uint64_t dueTicks = static_cast<std::uint64_t>(now - start) * Simulation::STEPS_PER_SECOND / 1000000;
+        bool advanced = false;
+        while (!over && session.getTick() < std::min(dueTicks, maxTicks))
+        {
+            if (!session.canAdvance())
+            {
+                ++stalledTicks;
+                break;
+            }
+            session.advance(ai.next(localField));
+            advanced = true;
+            over = (session.isFinished() || session.getTick() >= maxTicks) && session.isSettled();
+        }
+        ++frames;
+        worstFrameResimulations =
+            std::max(worstFrameResimulations, session.getStats().resimulatedTicks - resimulatedBefore);
+
+        // A packet per tick, and a tick's worth apart while waiting
+        if (advanced || now - lastSent >= 1000000 / Simulation::STEPS_PER_SECOND)
+        {
+            size = session.writePacket(packet.data(), packet.size());
+            link.send(packet.data(), size);
+            lastSent = now;
+        }
+
+        if (over && session.getAcknowledgedTick() >= session.getTick() && endedAt < 0)
+        {
+            endedAt = now;
+        }
+        if (endedAt >= 0 && now - endedAt >= LINGER_MICROSECONDS)
+        {
+            break;
+        }
+        if (now - lastHeard > PEER_TIMEOUT_MICROSECONDS)
+        {
+            timedOut = true;
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    const VersusSession::Stats& stats = session.getStats();
+    double seconds = static_cast<double>(InputQueue::now() - start) / 1e6;
+    double rollbacks = static_cast<double>(std::max<std::uint64_t>(stats.rollbacks, 1));
+    std::printf("ticks:     %llu in %.2f s (%llu frames waited for the peer)\n",
+                static_cast<unsigned long long>(session.getTick()), seconds,
+                static_cast<unsigned long long>(stalledTicks));
+    std::printf("rollbacks: %llu (%.1f%% of ticks), depth mean %.2f max %zu, %llu ticks resimulated\n",
+                static_cast<unsigned long long>(stats.rollbacks),
+                100.0 * static_cast<double>(stats.rollbacks) / std::max(1.0, static_cast<double>(stats.ticks)),
+                static_cast<double>(stats.resimulatedTicks) / rollbacks, stats.maxRollbackDepth,
+                static_cast<unsigned long long>(stats.resimulatedTicks));
+    std::printf("depths:   ");
+    for (std::size_t depth = 1; depth <= VersusSession::MAX_ROLLBACK; ++depth)
+    {
+        std::printf(" %llu", static_cast<unsigned long long>(stats.rollbackDepths[depth]));
+    }
+    std::printf("\n");
+    std::printf("resim:     %.1f us mean, %.1f us max per rollback; at most %llu ticks in one frame of %llu\n",
+                stats.totalResimulationMicroseconds / rollbacks, stats.maxResimulationMicroseconds,
+                static_cast<unsigned long long>(worstFrameResimulations), static_cast<unsigned long long>(frames));
+    const LinkConditioner::Stats& injected = link.getConditionerStats();
+    std::printf("packets:   %llu sent, %llu dropped on purpose, %llu read, %llu rejected\n",
+                static_cast<unsigned long long>(link.getStats().sent), static_cast<unsigned long long>(injected.lost),
+                static_cast<unsigned long long>(stats.packetsRead),
+                static_cast<unsigned long long>(stats.packetsRejected));
+
+    if (timedOut)
+    {
+        std::printf("Error: no packet from the peer for %lld s\n",
+                    static_cast<long long>(PEER_TIMEOUT_MICROSECONDS / 1000000));
+        return 2;
+    }
+    // At the time limit, the better score wins
+    int winner = session.getWinner();
+    if (!session.isFinished() && fields[0].getScore() != fields[1].getScore())
+    {
+        winner = fields[0].getScore() > fields[1].getScore() ? 0 : 1;
+    }
+    std::printf("result:    player 0 %d points, player 1 %d points, %s%s\n", fields[0].getScore(),
+                fields[1].getScore(), winner < 0 ? "draw" : (winner == 0 ? "player 0 wins" : "player 1 wins"),
+                session.isFinished() ? "" : " on time");
+    std::printf("hash:      %016llx\n", static_cast<unsigned long long>(session.computeStateHash()));
+    return 0;
+}